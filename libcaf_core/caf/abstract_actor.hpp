@@ -67,6 +67,14 @@ public:
   ///       with remote actors.
   virtual bool enqueue(mailbox_element_ptr what, execution_unit* host) = 0;
 
+  /// Enqueues the chain of messages that starts at `first`, i.e., `first` and
+  /// all of its successors via `next`, in order. The default implementation
+  /// enqueues each message individually. Actors with a lock-free mailbox
+  /// override this function to add all messages with a single atomic
+  /// operation.
+  /// @returns `true` if the actor accepted all messages, `false` otherwise.
+  virtual bool enqueue_batch(mailbox_element_ptr first, execution_unit* host);
+
   /// Attaches `ptr` to this actor. The actor will call `ptr->detach(...)` on
   /// exit, or immediately if it already finished execution.
   virtual void attach(attachable_ptr ptr) = 0;
@@ -108,6 +116,16 @@ public:
   ///          mailbox is empty or the actor does not have a mailbox.
   virtual mailbox_element* peek_at_next_mailbox_element();
 
+  /// Makes the actor count the messages in its mailbox. Actor pools call this
+  /// function on their workers to enable load-aware dispatching. The default
+  /// implementation does nothing.
+  virtual void track_queued_messages();
+
+  /// Returns the number of messages in the mailbox of this actor or 0 if the
+  /// actor does not count its messages. The result is only a snapshot, since
+  /// other threads may add messages at any time.
+  virtual size_t queued_messages() const noexcept;
+
   template <class... Ts>
   bool eq_impl(message_id mid, strong_actor_ptr sender, execution_unit* ctx,
                Ts&&... xs) {
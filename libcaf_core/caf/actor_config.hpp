@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <string>
 
 #include "caf/abstract_channel.hpp"
@@ -12,6 +13,7 @@
 #include "caf/detail/unique_function.hpp"
 #include "caf/fwd.hpp"
 #include "caf/input_range.hpp"
+#include "caf/mailbox_overflow_policy.hpp"
 
 namespace caf {
 
@@ -35,12 +37,32 @@ public:
   input_range<const group>* groups;
   detail::unique_function<behavior(local_actor*)> init_fun;
 
+  /// Selects a named scheduler pool for the new actor. A `nullptr` selects the
+  /// default scheduler of the actor system.
+  scheduler::abstract_coordinator* pool;
+
+  /// Limits the number of messages in the mailbox of the new actor. The
+  /// default value 0 leaves the mailbox unbounded.
+  size_t mailbox_capacity;
+
+  /// Selects what the new actor does with messages that arrive while its
+  /// mailbox is full.
+  mailbox_overflow_policy mailbox_overflow;
+
   // -- properties -------------------------------------------------------------
 
   actor_config& add_flag(int x) {
     flags |= x;
     return *this;
   }
+
+  /// Limits the mailbox of the new actor to `capacity` messages.
+  actor_config& bounded_mailbox(size_t capacity,
+                                mailbox_overflow_policy policy) {
+    mailbox_capacity = capacity;
+    mailbox_overflow = policy;
+    return *this;
+  }
 };
 
 /// @relates actor_config
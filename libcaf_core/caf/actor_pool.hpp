@@ -11,7 +11,10 @@
 #include "caf/mailbox_element.hpp"
 #include "caf/monitorable_actor.hpp"
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <vector>
 
@@ -37,16 +40,20 @@ namespace caf {
 /// Neither does it live in its own thread. Messages are dispatched immediately
 /// during the enqueue operation. Any user-defined policy thus has to dispatch
 /// messages with as little overhead as possible, because the dispatching
-/// runs in the context of the sender.
+/// runs in the context of the sender. Senders dispatch without locking: the
+/// policy receives an immutable snapshot of the workers and multiple senders
+/// may call the policy concurrently.
 /// @experimental
 class CAF_CORE_EXPORT actor_pool : public monitorable_actor {
 public:
   using actor_vec = std::vector<actor>;
   using factory = std::function<actor()>;
   using guard_type = std::unique_lock<std::mutex>;
-  using policy
-    = std::function<void(actor_system&, guard_type&, const actor_vec&,
-                         mailbox_element_ptr&, execution_unit*)>;
+  using policy = std::function<void(actor_system&, const actor_vec&,
+                                    mailbox_element_ptr&, execution_unit*)>;
+
+  /// Extracts the routing key from a message for `consistent_hash`.
+  using key_function = std::function<uint64_t(const message&)>;
 
   /// Returns a simple round robin dispatching policy.
   static policy round_robin();
@@ -57,6 +64,20 @@ public:
   /// Returns a random dispatching policy.
   static policy random();
 
+  /// Returns a dispatching policy that selects the worker with the fewest
+  /// messages in its mailbox. Scans all workers for each message.
+  static policy least_loaded();
+
+  /// Returns a dispatching policy that picks two workers at random and selects
+  /// the one with fewer messages in its mailbox. Balances almost as well as
+  /// `least_loaded` at constant cost per message.
+  static policy power_of_two();
+
+  /// Returns a dispatching policy that always routes messages with the same
+  /// key to the same worker, as long as the worker stays in the pool. Adding
+  /// or removing a worker only moves the keys of that worker.
+  static policy consistent_hash(key_function key);
+
   /// Returns a split/join dispatching policy. The function object `sf`
   /// distributes a work item to all workers (split step) and the function
   /// object `jf` joins individual results into a single one with `init`
@@ -105,8 +126,24 @@ private:
   // call without workers_mtx_ held
   void quit(execution_unit* host);
 
+  // monitors `worker` and enables counting of its queued messages
+  void init_worker(const actor& worker);
+
+  // call with workers_mtx_ held
+  void set_workers(actor_vec workers);
+
+  // guards modifications of the workers
   std::mutex workers_mtx_;
-  std::vector<actor> workers_;
+
+  // current set of workers, replaced as a whole on modifications
+  std::atomic<const actor_vec*> workers_;
+
+  // number of senders that currently access a snapshot of the workers
+  std::atomic<size_t> readers_;
+
+  // replaced snapshots that senders may still access, guarded by workers_mtx_
+  std::vector<std::unique_ptr<const actor_vec>> retired_;
+
   policy policy_;
   exit_reason planned_reason_;
 };
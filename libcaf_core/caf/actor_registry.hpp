@@ -8,10 +8,12 @@
 #include "caf/actor.hpp"
 #include "caf/actor_cast.hpp"
 #include "caf/actor_control_block.hpp"
+#include "caf/config.hpp"
 #include "caf/detail/core_export.hpp"
 #include "caf/fwd.hpp"
 #include "caf/telemetry/int_gauge.hpp"
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <cstdint>
@@ -29,6 +31,10 @@ namespace caf {
 /// independent from their ID at runtime. Note that the registry does *not*
 /// contain all actors of an actor system. The middleman registers actors as
 /// needed.
+///
+/// The registry splits actors into shards by their ID, each with its own lock.
+/// Hence, threads that register, look up or remove different actors rarely
+/// compete for the same lock.
 class CAF_CORE_EXPORT actor_registry {
 public:
   friend class actor_system;
@@ -55,6 +61,9 @@ public:
   /// @returns the increased count.
   size_t inc_running();
 
+  /// Increases running-actors-count by `n`.
+  void inc_running(size_t n);
+
   /// Decreases running-actors-count by one.
   /// @returns the decreased count.
   size_t dec_running();
@@ -108,13 +117,30 @@ private:
 
   using entries = std::unordered_map<actor_id, strong_actor_ptr>;
 
+  /// Number of shards for actors by ID. Must be a power of two.
+  static constexpr size_t num_shards = 64;
+
+  /// Stores the actors with `id % num_shards` equal to the index of the shard.
+  /// Keeps each shard on its own cache line to avoid false sharing.
+  struct alignas(CAF_CACHE_LINE_SIZE) shard {
+    mutable std::mutex mtx;
+    entries actors;
+  };
+
   actor_registry(actor_system& sys);
 
+  shard& shard_of(actor_id key) noexcept {
+    return shards_[key & (num_shards - 1)];
+  }
+
+  const shard& shard_of(actor_id key) const noexcept {
+    return shards_[key & (num_shards - 1)];
+  }
+
   mutable std::mutex running_mtx_;
   mutable std::condition_variable running_cv_;
 
-  mutable std::shared_mutex instances_mtx_;
-  entries entries_;
+  std::array<shard, num_shards> shards_;
 
   name_map named_entries_;
   mutable std::shared_mutex named_entries_mtx_;
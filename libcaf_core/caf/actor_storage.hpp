@@ -12,6 +12,7 @@
 #include "caf/abstract_actor.hpp"
 #include "caf/actor_control_block.hpp"
 #include "caf/config.hpp"
+#include "caf/detail/actor_storage_cache.hpp"
 
 #ifdef CAF_GCC
 #  pragma GCC diagnostic push
@@ -58,6 +59,23 @@ public:
   actor_storage(const actor_storage&) = delete;
   actor_storage& operator=(const actor_storage&) = delete;
 
+  // Recycles the memory of terminated actors once the last weak reference to
+  // the control block expires.
+
+  static void* operator new(size_t size) {
+    if constexpr (is_overaligned)
+      return ::operator new(size, std::align_val_t{alignof(actor_storage)});
+    else
+      return detail::actor_storage_cache::allocate(size);
+  }
+
+  static void operator delete(void* ptr, size_t size) noexcept {
+    if constexpr (is_overaligned)
+      ::operator delete(ptr, std::align_val_t{alignof(actor_storage)});
+    else
+      detail::actor_storage_cache::deallocate(ptr, size);
+  }
+
   static_assert(sizeof(actor_control_block) < CAF_CACHE_LINE_SIZE,
                 "actor_control_block exceeds 64 bytes");
 
@@ -68,6 +86,9 @@ public:
   };
 
 private:
+  static constexpr bool is_overaligned
+    = alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
   static void data_dtor(abstract_actor* ptr) {
     // safe due to static assert #3
     ptr->on_destroy();
@@ -14,6 +14,7 @@
 #include <string>
 #include <thread>
 #include <typeinfo>
+#include <vector>
 
 #include "caf/abstract_actor.hpp"
 #include "caf/actor_cast.hpp"
@@ -212,6 +213,30 @@ public:
 
     /// Counts the total number of messages that wait in a mailbox.
     telemetry::int_gauge* queued_messages;
+
+    /// Counts how often actors yielded to other actors with messages left in
+    /// their mailbox after reaching the maximum throughput.
+    telemetry::int_counter* max_throughput_yields;
+
+    /// Counts how often actors yielded to other actors with messages left in
+    /// their mailbox after exceeding the maximum run time.
+    telemetry::int_counter* max_run_time_yields;
+
+    /// Counts the number of messages that bounded mailboxes dropped because
+    /// they reached their capacity.
+    telemetry::int_counter* dropped_messages;
+
+    /// Counts the number of messages that replaced an older message with the
+    /// same key in a conflating mailbox.
+    telemetry::int_counter* conflated_messages;
+
+    /// Tracks the current number of threads for detached actors, including
+    /// idle threads.
+    telemetry::int_gauge* private_threads;
+
+    /// Counts how often a detached actor started on an idle thread instead of
+    /// a new thread.
+    telemetry::int_counter* reused_private_threads;
   };
 
   /// Metrics that some actors may collect in addition to the base metrics. All
@@ -228,6 +253,9 @@ public:
     /// Counts how many messages are currently waiting in the mailbox.
     telemetry::int_gauge_family* mailbox_size = nullptr;
 
+    /// Counts how many responses the actor currently waits for.
+    telemetry::int_gauge_family* pending_requests = nullptr;
+
     struct {
       // -- inbound ------------------------------------------------------------
 
@@ -326,6 +354,10 @@ public:
   /// Returns the scheduler instance.
   scheduler::abstract_coordinator& scheduler();
 
+  /// Returns the named scheduler pool `name` from `caf.scheduler.pools` or
+  /// `nullptr` if no such pool exists.
+  scheduler::abstract_coordinator* scheduler_pool(std::string_view name);
+
   /// Returns the system-wide event logger.
   caf::logger& logger();
 
@@ -363,6 +395,10 @@ public:
   /// Returns a new actor ID.
   actor_id next_actor_id();
 
+  /// Reserves `n` consecutive actor IDs.
+  /// @returns the first reserved ID.
+  actor_id next_actor_ids(size_t n);
+
   /// Returns the last given actor ID.
   actor_id latest_actor_id() const;
 
@@ -440,6 +476,109 @@ public:
                              std::forward<Ts>(xs)...);
   }
 
+  /// Returns `n` new actors of type `C`, each constructed from `xs...`.
+  /// Compared to calling `spawn` `n` times, reserves all actor IDs at once
+  /// and increases the running-actors count only once.
+  template <class C, spawn_options Os = no_spawn_options, class... Ts>
+  std::vector<infer_handle_from_class_t<C>> spawn_n(size_t n,
+                                                    const Ts&... xs) {
+    check_invariants<C>();
+    static_assert(is_unbound(Os),
+                  "top-level spawns cannot have monitor or link flag");
+    static_assert(!std::is_base_of_v<blocking_actor, C>,
+                  "spawn_n only supports event-based actors");
+    std::vector<infer_handle_from_class_t<C>> result;
+    if (n == 0)
+      return result;
+    result.reserve(n);
+    actor_config cfg{dummy_execution_unit()};
+    if constexpr (has_detach_flag(Os))
+      cfg.flags |= abstract_actor::is_detached_flag;
+    if constexpr (has_hide_flag(Os))
+      cfg.flags |= abstract_actor::is_hidden_flag;
+    CAF_SET_LOGGER_SYS(this);
+    auto first_id = next_actor_ids(n);
+    for (size_t i = 0; i < n; ++i)
+      result.emplace_back(make_actor<C>(first_id + i, node(), this, cfg,
+                                        detail::spawn_fwd<const Ts&>(xs)...));
+    if constexpr (!has_hide_flag(Os)) {
+      // Launching skips actors that are already registered.
+      registry().inc_running(n);
+      for (auto& hdl : result)
+        actor_cast<abstract_actor*>(hdl)->setf(
+          abstract_actor::is_registered_flag);
+    }
+    for (auto& hdl : result) {
+      auto ptr = static_cast<C*>(actor_cast<abstract_actor*>(hdl));
+#ifdef CAF_ENABLE_ACTOR_PROFILER
+      profiler_add_actor(*ptr, cfg.parent);
+#endif
+      ptr->launch(cfg.host, has_lazy_init_flag(Os), has_hide_flag(Os));
+    }
+    return result;
+  }
+
+  /// Returns a new class-based actor that runs in the named scheduler pool
+  /// `pool`. The name `default` selects the default scheduler.
+  /// @throws std::invalid_argument if `caf.scheduler.pools` contains no such
+  ///         pool.
+  template <class C, spawn_options Os = no_spawn_options, class... Ts>
+  infer_handle_from_class_t<C> spawn_in_pool(std::string_view pool,
+                                             Ts&&... xs) {
+    check_invariants<C>();
+    actor_config cfg;
+    cfg.pool = spawn_pool(pool);
+    return spawn_impl<C, Os>(cfg, detail::spawn_fwd<Ts>(xs)...);
+  }
+
+  /// Returns a new functor-based actor that runs in the named scheduler pool
+  /// `pool`. The name `default` selects the default scheduler.
+  /// @throws std::invalid_argument if `caf.scheduler.pools` contains no such
+  ///         pool.
+  template <spawn_options Os = no_spawn_options, class F, class... Ts>
+  infer_handle_from_fun_t<F>
+  spawn_in_pool(std::string_view pool, F fun, Ts&&... xs) {
+    using impl = infer_impl_from_fun_t<F>;
+    check_invariants<impl>();
+    static constexpr bool spawnable = detail::spawnable<F, impl, Ts...>();
+    static_assert(spawnable,
+                  "cannot spawn function-based actor with given arguments");
+    actor_config cfg;
+    cfg.pool = spawn_pool(pool);
+    return spawn_functor<Os>(detail::bool_token<spawnable>{}, cfg, fun,
+                             std::forward<Ts>(xs)...);
+  }
+
+  /// Returns a new class-based actor with a mailbox that holds at most
+  /// `capacity` messages. The actor handles additional messages according to
+  /// `policy`.
+  template <class C, spawn_options Os = no_spawn_options, class... Ts>
+  infer_handle_from_class_t<C>
+  spawn_bounded(size_t capacity, mailbox_overflow_policy policy, Ts&&... xs) {
+    check_invariants<C>();
+    actor_config cfg;
+    cfg.bounded_mailbox(capacity, policy);
+    return spawn_impl<C, Os>(cfg, detail::spawn_fwd<Ts>(xs)...);
+  }
+
+  /// Returns a new functor-based actor with a mailbox that holds at most
+  /// `capacity` messages. The actor handles additional messages according to
+  /// `policy`.
+  template <spawn_options Os = no_spawn_options, class F, class... Ts>
+  infer_handle_from_fun_t<F> spawn_bounded(size_t capacity,
+                                           mailbox_overflow_policy policy,
+                                           F fun, Ts&&... xs) {
+    using impl = infer_impl_from_fun_t<F>;
+    check_invariants<impl>();
+    static constexpr bool spawnable = detail::spawnable<F, impl, Ts...>();
+    static_assert(spawnable,
+                  "cannot spawn function-based actor with given arguments");
+    actor_config cfg;
+    cfg.bounded_mailbox(capacity, policy);
+    return spawn_functor<Os>(detail::bool_token<spawnable>{}, cfg, fun,
+                             std::forward<Ts>(xs)...);
+  }
+
   /// Returns a new actor with run-time type `name`, constructed
   /// with the arguments stored in `args`.
   /// @experimental
@@ -600,6 +739,10 @@ public:
     return metrics_actors_excludes_;
   }
 
+  const auto& metrics_actors_sample_rates() const noexcept {
+    return metrics_actors_sample_rates_;
+  }
+
   template <class C, spawn_options Os, class... Ts>
   infer_handle_from_class_t<C> spawn_impl(actor_config& cfg, Ts&&... xs) {
     static_assert(is_unbound(Os),
@@ -776,6 +919,10 @@ private:
                   "Probably you have tried to spawn a broker.");
   }
 
+  /// Returns the scheduler pool for `spawn_in_pool` or `nullptr` for the
+  /// default scheduler.
+  scheduler::abstract_coordinator* spawn_pool(std::string_view name);
+
   expected<strong_actor_ptr>
   dyn_spawn_impl(const std::string& name, message& args, execution_unit* ctx,
                  bool check_interface, const mpi* expected_ifs);
@@ -819,6 +966,9 @@ private:
   /// Stores optional actor system components.
   module_array modules_;
 
+  /// Stores the named scheduler pools from `caf.scheduler.pools`.
+  std::vector<module_ptr> pools_;
+
   /// Provides pseudo scheduling context to actors.
   scoped_execution_unit dummy_execution_unit_;
 
@@ -855,6 +1005,10 @@ private:
   /// for faster lookups at runtime.
   std::vector<std::string> metrics_actors_excludes_;
 
+  /// Caches the configuration parameter
+  /// `caf.metrics-filters.actors.sample-rates` for faster lookups at runtime.
+  std::vector<std::pair<std::string, size_t>> metrics_actors_sample_rates_;
+
   /// Caches families for optional actor metrics.
   actor_metric_families_t actor_metric_families_;
 
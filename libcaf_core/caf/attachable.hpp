@@ -71,6 +71,11 @@ public:
   /// Returns `true` if `what` selects this instance, otherwise `false`.
   virtual bool matches(const token& what);
 
+  /// Returns the subtype of tokens that may select this instance. Actors use
+  /// the subtype to store instances in an index. The default implementation
+  /// returns `token::anonymous`.
+  virtual size_t token_type() const noexcept;
+
   /// Returns `true` if `what` selects this instance, otherwise `false`.
   template <class T>
   bool matches(const T& what) {
@@ -14,6 +14,7 @@
 #include "caf/none.hpp"
 #include "caf/timeout_definition.hpp"
 #include "caf/timespan.hpp"
+#include "caf/type_id_list.hpp"
 #include "caf/unsafe_behavior_init.hpp"
 
 namespace caf {
@@ -95,6 +96,12 @@ public:
     return impl_ ? impl_->invoke(f, xs) : false;
   }
 
+  /// Checks whether this behavior may have a handler for messages with the
+  /// types `xs`.
+  bool accepts(type_id_list xs) const noexcept {
+    return impl_ ? impl_->accepts(xs) : false;
+  }
+
   /// Checks whether this behavior is not empty.
   operator bool() const {
     return static_cast<bool>(impl_);
@@ -347,6 +347,11 @@ public:
   mailbox_type& mailbox() {
     return mailbox_;
   }
+
+  /// Drops the oldest ordinary messages until the bounded mailbox no longer
+  /// exceeds its capacity.
+  void drop_oldest_messages();
+
   /// @cond PRIVATE
 
   /// Receives messages until either a pre- or postcheck of `rcc` fails.
@@ -24,6 +24,21 @@ public:
 
   bool matches(const token& what) override;
 
+  size_t token_type() const noexcept override;
+
+  /// Sends `msg` to the observer with `sender` as source. Allows an actor to
+  /// share a single `down_msg` or `exit_msg` among all of its observers.
+  void notify(const strong_actor_ptr& sender, const message& msg,
+              execution_unit* host);
+
+  const actor_addr& observer() const noexcept {
+    return observer_;
+  }
+
+  observe_type type() const noexcept {
+    return type_;
+  }
+
   static attachable_ptr
   make_monitor(actor_addr observed, actor_addr observer,
                message_priority prio = message_priority::normal) {
@@ -94,21 +94,36 @@ constexpr auto buffer_size = int32_t{4096}; // // 32 KB for elements of size 8.
 namespace caf::defaults::scheduler {
 
 constexpr auto policy = std::string_view{"stealing"};
-constexpr auto profiling_output_file = std::string_view{""};
 constexpr auto max_throughput = std::numeric_limits<size_t>::max();
-constexpr auto profiling_resolution = timespan(100'000'000);
+constexpr auto pin_workers = false;
+constexpr auto max_run_time = timespan{0};
+constexpr auto drr_quantum = size_t{3};
+constexpr auto max_drr_quantum = size_t{48};
+constexpr auto stall_threshold = timespan{0};
+constexpr auto replace_stalled_workers = false;
+constexpr auto trace_file = std::string_view{""};
+constexpr auto trace_buffer_size = size_t{16384};
+constexpr auto trace_flush_interval = timespan{100'000'000};
 
 } // namespace caf::defaults::scheduler
 
+namespace caf::defaults::private_threads {
+
+constexpr auto max_idle = size_t{16};
+constexpr auto idle_timeout = timespan{10'000'000'000};
+
+} // namespace caf::defaults::private_threads
+
 namespace caf::defaults::work_stealing {
 
 constexpr auto aggressive_poll_attempts = size_t{100};
 constexpr auto aggressive_steal_interval = size_t{10};
+constexpr auto aggressive_steal_batch_size = size_t{32};
 constexpr auto moderate_poll_attempts = size_t{500};
 constexpr auto moderate_steal_interval = size_t{5};
 constexpr auto moderate_sleep_duration = timespan{50'000};
-constexpr auto relaxed_steal_interval = size_t{1};
-constexpr auto relaxed_sleep_duration = timespan{10'000'000};
+constexpr auto moderate_steal_batch_size = size_t{8};
+constexpr auto max_next_slot_runs = size_t{16};
 
 } // namespace caf::defaults::work_stealing
 
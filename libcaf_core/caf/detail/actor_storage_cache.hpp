@@ -0,0 +1,43 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include <cstddef>
+
+#include "caf/config.hpp"
+#include "caf/detail/core_export.hpp"
+#include "caf/detail/slab_allocator.hpp"
+
+namespace caf::detail {
+
+/// Recycles the memory of actors. Each thread keeps a free list per size
+/// class, i.e., actor types with storage of similar size share a list. Threads
+/// exchange blocks with other threads in batches over a shared depot, since
+/// actors often terminate on a different thread than the one spawning them.
+///
+/// The cache never returns memory to the operating system. Hence, the memory
+/// that the cache holds matches the peak number of actors alive at the same
+/// time. Builds with the address sanitizer always use the regular heap.
+class CAF_CORE_EXPORT actor_storage_cache {
+public:
+  /// Stores whether the cache recycles memory.
+  static constexpr bool enabled = slab_allocator::enabled;
+
+  /// Size difference between two neighboring size classes.
+  static constexpr size_t granularity = CAF_CACHE_LINE_SIZE;
+
+  /// Largest block size in bytes that the cache recycles. Larger blocks go to
+  /// the regular heap.
+  static constexpr size_t max_block_size = 4096;
+
+  /// Allocates `size` bytes, aligned to `__STDCPP_DEFAULT_NEW_ALIGNMENT__`.
+  /// @throws std::bad_alloc if no memory is available.
+  static void* allocate(size_t size);
+
+  /// Releases a block of `size` bytes previously returned by `allocate`.
+  static void deallocate(void* ptr, size_t size) noexcept;
+};
+
+} // namespace caf::detail
@@ -33,6 +33,15 @@ decltype(auto) apply_args(F& f, Tuple& tup) {
   return apply_args(f, token, tup);
 }
 
+/// Calls `f` with the elements of `tup`, casting each element to the matching
+/// type in `Args`. Hence, `f` may move from elements that it takes by value or
+/// as rvalue reference.
+template <class F, size_t... Is, class Tuple, class... Args>
+decltype(auto) apply_forwarded_args(F& f, std::index_sequence<Is...>,
+                                    Tuple& tup, type_list<Args...>) {
+  return f(static_cast<Args&&>(get<Is>(tup))...);
+}
+
 template <class F, long... Is, class Tuple>
 auto apply_moved_args(F& f, detail::int_list<Is...>, Tuple& tup)
   -> decltype(f(std::move(get<Is>(tup))...)) {
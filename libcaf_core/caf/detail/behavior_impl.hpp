@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <optional>
 #include <tuple>
 #include <type_traits>
@@ -24,6 +26,8 @@
 #include "caf/skip.hpp"
 #include "caf/timeout_definition.hpp"
 #include "caf/timespan.hpp"
+#include "caf/type_id.hpp"
+#include "caf/type_id_list.hpp"
 #include "caf/typed_message_view.hpp"
 #include "caf/typed_response_promise.hpp"
 
@@ -53,6 +57,10 @@ public:
 
   virtual void handle_timeout();
 
+  /// Checks whether this behavior may have a handler for messages with the
+  /// types `xs`. The default implementation always returns `true`.
+  virtual bool accepts(type_id_list xs) const noexcept;
+
   timespan timeout() const noexcept {
     return timeout_;
   }
@@ -87,6 +95,81 @@ struct dummy_timeout_definition {
   }
 };
 
+/// Computes the hash value of a list of type IDs for dispatching messages.
+/// @private
+constexpr uint32_t type_ids_hash_step(uint32_t seed, type_id_t x) noexcept {
+  // FNV-1a step.
+  return (seed ^ x) * 16777619u;
+}
+
+/// @private
+inline uint32_t type_ids_hash(type_id_list xs) noexcept {
+  auto result = type_ids_hash_step(2166136261u, xs.size());
+  for (auto x : xs)
+    result = type_ids_hash_step(result, x);
+  return result;
+}
+
+/// @private
+template <class... Ts>
+constexpr uint32_t type_ids_hash(type_list<Ts...>) noexcept {
+  auto result = type_ids_hash_step(2166136261u, sizeof...(Ts));
+  ((result = type_ids_hash_step(result,
+                                type_id_v<typename strip_param<Ts>::type>)),
+   ...);
+  return result;
+}
+
+/// Maps the hash values of the argument types of `N` message handlers to the
+/// index of the handler. The table uses linear probing and inserts handlers
+/// in their order of definition. Hence, a lookup visits handlers with the same
+/// argument types in their order of definition.
+/// @private
+template <size_t N>
+class behavior_index {
+public:
+  struct entry {
+    uint32_t hash = 0;
+    uint32_t index = N;
+  };
+
+  /// Number of slots in the table, i.e., the smallest power of two that keeps
+  /// the load factor below 0.5.
+  static constexpr size_t capacity() noexcept {
+    size_t result = 2;
+    while (result < 2 * N)
+      result <<= 1;
+    return result;
+  }
+
+  constexpr explicit behavior_index(const std::array<uint32_t, N>& hashes)
+    : slots_() {
+    constexpr auto mask = capacity() - 1;
+    for (size_t index = 0; index < N; ++index) {
+      auto pos = hashes[index] & mask;
+      while (slots_[pos].index != N)
+        pos = (pos + 1) & mask;
+      slots_[pos].hash = hashes[index];
+      slots_[pos].index = static_cast<uint32_t>(index);
+    }
+  }
+
+  /// Calls `f` with the index of each handler that may match `hash` until `f`
+  /// returns `true`.
+  template <class F>
+  bool find(uint32_t hash, F&& f) const {
+    constexpr auto mask = capacity() - 1;
+    for (auto pos = hash & mask; slots_[pos].index != N;
+         pos = (pos + 1) & mask)
+      if (slots_[pos].hash == hash && f(slots_[pos].index))
+        return true;
+    return false;
+  }
+
+private:
+  std::array<entry, capacity()> slots_;
+};
+
 template <class Tuple, class TimeoutDefinition = dummy_timeout_definition>
 class default_behavior_impl;
 
@@ -105,39 +188,88 @@ public:
     // nop
   }
 
+  /// Behaviors with more handlers than this threshold look up the handler for
+  /// a message in a hash table instead of trying each handler in turn.
+  static constexpr size_t index_threshold = 8;
+
   virtual bool invoke(detail::invoke_result_visitor& f, message& xs) override {
-    return invoke_impl(f, xs, std::make_index_sequence<sizeof...(Ts)>{});
+    using indexes = std::make_index_sequence<sizeof...(Ts)>;
+    if constexpr (sizeof...(Ts) > index_threshold)
+      return invoke_indexed(f, xs, indexes{});
+    else
+      return invoke_impl(f, xs, indexes{});
   }
 
   template <size_t... Is>
   bool invoke_impl(detail::invoke_result_visitor& f, message& msg,
                    std::index_sequence<Is...>) {
-    [[maybe_unused]] auto dispatch = [&](auto& fun) {
-      using fun_type = std::decay_t<decltype(fun)>;
-      using trait = get_callable_trait_t<fun_type>;
-      auto arg_types = to_type_id_list<typename trait::decayed_arg_types>();
-      if (arg_types == msg.types()) {
-        typename trait::message_view_type xs{msg};
-        using fun_result = decltype(detail::apply_args(fun, xs));
-        if constexpr (std::is_same<void, fun_result>::value) {
-          detail::apply_args(fun, xs);
-          f(unit);
-        } else {
-          auto invoke_res = detail::apply_args(fun, xs);
-          f(invoke_res);
-        }
-        return true;
-      }
-      return false;
-    };
-    return (dispatch(std::get<Is>(cases_)) || ...);
+    return (dispatch(std::get<Is>(cases_), f, msg) || ...);
+  }
+
+  template <size_t... Is>
+  bool invoke_indexed(detail::invoke_result_visitor& f, message& msg,
+                      std::index_sequence<Is...>) {
+    using dispatch_fn = bool (*)(default_behavior_impl&, invoke_result_visitor&,
+                                 message&);
+    static constexpr dispatch_fn jump_table[] = {&dispatch_at<Is>...};
+    static constexpr behavior_index<sizeof...(Ts)> index{
+      std::array<uint32_t, sizeof...(Ts)>{type_ids_hash(
+        typename get_callable_trait_t<Ts>::decayed_arg_types{})...}};
+    return index.find(type_ids_hash(msg.types()), [&](size_t case_index) {
+      return jump_table[case_index](*this, f, msg);
+    });
   }
 
   void handle_timeout() override {
     timeout_definition_.handler();
   }
 
+  bool accepts([[maybe_unused]] type_id_list xs) const noexcept override {
+    return ((to_type_id_list<
+               typename get_callable_trait_t<Ts>::decayed_arg_types>()
+             == xs)
+            || ...);
+  }
+
 private:
+  template <class Fun>
+  static bool dispatch(Fun& fun, detail::invoke_result_visitor& f,
+                       message& msg) {
+    using trait = get_callable_trait_t<Fun>;
+    auto arg_types = to_type_id_list<typename trait::decayed_arg_types>();
+    if (arg_types == msg.types()) {
+      // Note: the view for handlers with mutable arguments detaches `msg` if
+      //       other messages share its content. Hence, handlers that take
+      //       rvalue references may always move from the elements.
+      typename trait::message_view_type xs{msg};
+      auto call = [&fun, &xs]() -> decltype(auto) {
+        if constexpr (trait::moves_args) {
+          using indexes = std::make_index_sequence<trait::num_args>;
+          return detail::apply_forwarded_args(fun, indexes{}, xs,
+                                              typename trait::arg_types{});
+        } else {
+          return detail::apply_args(fun, xs);
+        }
+      };
+      using fun_result = decltype(call());
+      if constexpr (std::is_same<void, fun_result>::value) {
+        call();
+        f(unit);
+      } else {
+        auto invoke_res = call();
+        f(invoke_res);
+      }
+      return true;
+    }
+    return false;
+  }
+
+  template <size_t I>
+  static bool dispatch_at(default_behavior_impl& self,
+                          detail::invoke_result_visitor& f, message& msg) {
+    return dispatch(std::get<I>(self.cases_), f, msg);
+  }
+
   tuple_type cases_;
 
   TimeoutDefinition timeout_definition_;
@@ -0,0 +1,119 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "caf/detail/core_export.hpp"
+
+namespace caf::detail {
+
+/// Describes where a logical CPU resides in the memory hierarchy.
+struct cpu_location {
+  /// ID of the logical CPU.
+  size_t cpu;
+
+  /// ID of the L3 cache shared by this CPU, i.e., the lowest ID of all CPUs
+  /// that share the cache.
+  size_t l3;
+
+  /// ID of the NUMA node of this CPU.
+  size_t node;
+};
+
+/// Classifies the distance between two logical CPUs.
+enum class cpu_locality {
+  /// Both CPUs share an L3 cache.
+  same_l3,
+  /// Both CPUs belong to the same NUMA node but have separate L3 caches.
+  same_node,
+  /// The CPUs belong to different NUMA nodes.
+  remote,
+};
+
+/// Number of distinct values in `cpu_locality`.
+constexpr size_t num_cpu_localities = 3;
+
+/// Returns a human-readable label for `x`.
+CAF_CORE_EXPORT std::string_view to_label(cpu_locality x) noexcept;
+
+/// Stores the CPU topology of the host system.
+class CAF_CORE_EXPORT cpu_topology {
+public:
+  cpu_topology() = default;
+
+  /// Creates a topology from `cpus`, ordering the CPUs by NUMA node, L3 cache
+  /// and ID.
+  explicit cpu_topology(std::vector<cpu_location> cpus);
+
+  /// Reads the CPU topology from sysfs.
+  /// @returns an empty topology if `sysfs_dir` does not provide the required
+  ///          information, e.g., when not running on Linux.
+  static cpu_topology
+  read(const std::string& sysfs_dir = "/sys/devices/system");
+
+  /// Removes all CPUs that are not in `allowed`, e.g., CPUs that the process
+  /// may not run on due to its affinity mask or its cgroup.
+  void restrict_to(const std::vector<size_t>& allowed);
+
+  /// Shifts the assignment of workers to CPUs by `n`, i.e., worker 0 runs on
+  /// the CPU that worker `n` would run on otherwise. Allows multiple sets of
+  /// workers to run on separate CPUs.
+  void rotate(size_t n);
+
+  /// Returns whether this topology contains no CPUs.
+  bool empty() const noexcept {
+    return cpus_.empty();
+  }
+
+  /// Returns the number of logical CPUs.
+  size_t size() const noexcept {
+    return cpus_.size();
+  }
+
+  /// Returns all CPUs, ordered by NUMA node, L3 cache and ID.
+  const std::vector<cpu_location>& cpus() const noexcept {
+    return cpus_;
+  }
+
+  /// Returns the CPU for the worker with ID `worker_id`. Assigns consecutive
+  /// worker IDs to CPUs that are close to each other.
+  /// @pre `!empty()`
+  const cpu_location& cpu_for_worker(size_t worker_id) const noexcept {
+    return cpus_[worker_id % cpus_.size()];
+  }
+
+  /// Returns the locality of the CPUs that run the workers `x` and `y`.
+  /// @pre `!empty()`
+  cpu_locality worker_locality(size_t x, size_t y) const noexcept {
+    return locality(cpu_for_worker(x), cpu_for_worker(y));
+  }
+
+  /// Returns the locality of `x` and `y`.
+  static cpu_locality locality(const cpu_location& x,
+                               const cpu_location& y) noexcept;
+
+private:
+  std::vector<cpu_location> cpus_;
+};
+
+/// Parses a list of CPU IDs in the sysfs format, e.g., `0-3,8,10-11`.
+CAF_CORE_EXPORT bool parse_cpu_list(std::string_view str,
+                                    std::vector<size_t>& result);
+
+/// Reads the IDs of all logical CPUs that the calling thread may run on.
+/// @returns `true` on success, `false` if the platform does not support
+///          querying the affinity of threads or if the system call failed.
+CAF_CORE_EXPORT bool get_thread_affinity(std::vector<size_t>& result);
+
+/// Pins the calling thread to the logical CPU `cpu`.
+/// @returns `true` on success, `false` if the platform does not support
+///          pinning threads or if the system call failed.
+CAF_CORE_EXPORT bool set_thread_affinity(size_t cpu);
+
+} // namespace caf::detail
@@ -6,6 +6,7 @@
 
 #include "caf/config.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <condition_variable>
@@ -101,6 +102,19 @@ public:
     return nullptr;
   }
 
+  // Removes up to half of the elements (rounded up) but no more than
+  // `max_count` from the tail and writes them to `out`, newest element first.
+  template <class OutputIterator>
+  size_t try_take_tail_half(size_t max_count, OutputIterator out) {
+    std::unique_lock guard{mtx_};
+    auto count = std::min((items_.size() + 1) / 2, max_count);
+    for (size_t i = 0; i < count; ++i) {
+      *out++ = items_.back();
+      items_.pop_back();
+    }
+    return count;
+  }
+
 private:
   std::mutex mtx_;
   std::condition_variable cv_;
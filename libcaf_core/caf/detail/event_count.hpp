@@ -0,0 +1,84 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include "caf/detail/core_export.hpp"
+
+namespace caf::detail {
+
+/// Allows threads to park until another thread signals new work without
+/// missing wakeups. Waiting is a two-phase protocol:
+///
+/// ~~~
+/// auto key = ec.prepare_wait();
+/// if (has_work()) {
+///   ec.cancel_wait();
+///   return;
+/// }
+/// ec.wait(key);
+/// ~~~
+///
+/// Notifiers only pay for a fence and an atomic load as long as no thread is
+/// parked.
+class CAF_CORE_EXPORT event_count {
+public:
+  using key_type = uint32_t;
+
+  event_count() : state_(0) {
+    // nop
+  }
+
+  event_count(const event_count&) = delete;
+
+  event_count& operator=(const event_count&) = delete;
+
+  /// Registers the calling thread as waiter and returns a key for `wait`.
+  key_type prepare_wait() noexcept;
+
+  /// Unregisters the calling thread after `prepare_wait` when not calling
+  /// `wait`, e.g., because the thread found work after all.
+  void cancel_wait() noexcept;
+
+  /// Blocks until another thread calls `notify_one` or `notify_all` after the
+  /// call to `prepare_wait` that produced `key`.
+  void wait(key_type key);
+
+  /// Wakes up one parked thread, if any.
+  void notify_one();
+
+  /// Wakes up all parked threads.
+  void notify_all();
+
+  /// Returns the number of threads that are currently parked or about to park.
+  size_t num_waiters() const noexcept {
+    return static_cast<size_t>(state_.load(std::memory_order_relaxed)
+                               & waiter_mask);
+  }
+
+private:
+  static constexpr uint64_t waiter_mask = 0xFFFFFFFF;
+
+  static constexpr int epoch_shift = 32;
+
+  static constexpr uint64_t epoch_inc = uint64_t{1} << epoch_shift;
+
+  bool has_waiters() const noexcept;
+
+  /// Stores the epoch in the upper 32 bits and the number of waiters in the
+  /// lower 32 bits.
+  std::atomic<uint64_t> state_;
+
+  std::mutex mtx_;
+
+  std::condition_variable cv_;
+};
+
+} // namespace caf::detail
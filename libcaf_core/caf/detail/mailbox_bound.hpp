@@ -0,0 +1,84 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+#include "caf/detail/core_export.hpp"
+#include "caf/mailbox_overflow_policy.hpp"
+
+namespace caf::detail {
+
+/// Keeps track of the number of messages in a bounded mailbox. Senders reserve
+/// a slot before enqueueing a message and the receiver releases the slot after
+/// processing or dropping the message.
+class CAF_CORE_EXPORT mailbox_bound {
+public:
+  mailbox_bound(size_t capacity, mailbox_overflow_policy policy) noexcept;
+
+  mailbox_bound(const mailbox_bound&) = delete;
+
+  mailbox_bound& operator=(const mailbox_bound&) = delete;
+
+  /// Returns the maximum number of messages in the mailbox.
+  size_t capacity() const noexcept {
+    return capacity_;
+  }
+
+  /// Returns the policy for messages that arrive while the mailbox is full.
+  mailbox_overflow_policy policy() const noexcept {
+    return policy_;
+  }
+
+  /// Returns the current number of reserved slots.
+  size_t size() const noexcept {
+    return size_.load(std::memory_order_relaxed);
+  }
+
+  /// Returns how many messages the mailbox holds above its capacity.
+  size_t excess() const noexcept {
+    auto n = size();
+    return n > capacity_ ? n - capacity_ : 0;
+  }
+
+  /// Reserves a slot if the mailbox is not full.
+  /// @returns `true` if the caller may enqueue its message.
+  /// @threadsafe
+  bool try_reserve() noexcept;
+
+  /// Reserves a slot regardless of the capacity.
+  /// @threadsafe
+  void force_reserve() noexcept {
+    size_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /// Reserves a slot, waiting for the receiver to release a slot if necessary.
+  /// @returns `false` if the receiver closed the mailbox while waiting.
+  /// @threadsafe
+  bool reserve_or_wait();
+
+  /// Releases `n` slots and wakes up waiting senders.
+  void release(size_t n = 1) noexcept;
+
+  /// Wakes up all waiting senders and stops blocking new senders.
+  void close();
+
+private:
+  size_t capacity_;
+  mailbox_overflow_policy policy_;
+  std::atomic<size_t> size_;
+
+  // -- state for blocking senders ---------------------------------------------
+
+  std::atomic<size_t> waiters_;
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  bool closed_;
+};
+
+} // namespace caf::detail
@@ -0,0 +1,64 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "caf/detail/core_export.hpp"
+#include "caf/detail/unique_function.hpp"
+#include "caf/fwd.hpp"
+#include "caf/type_id_list.hpp"
+
+namespace caf::detail {
+
+/// Keeps track of the latest queued message per key for a conflating mailbox.
+/// When a new message has the same key as a queued message, the new message
+/// replaces the content of the queued message and the actor drops the new
+/// message. Hence, the replacement keeps the position of the older message.
+///
+/// Only asynchronous messages take part in conflation, since dropping a
+/// request would leave its sender without a response.
+class CAF_CORE_EXPORT mailbox_conflation {
+public:
+  /// Extracts the key from a message.
+  using key_function = unique_function<std::string(const message&)>;
+
+  mailbox_conflation() = default;
+
+  mailbox_conflation(const mailbox_conflation&) = delete;
+
+  mailbox_conflation& operator=(const mailbox_conflation&) = delete;
+
+  /// Conflates messages with the types `types` by the key that `fn` returns.
+  /// Replaces the previous key function for `types`, if present.
+  void add(type_id_list types, key_function fn);
+
+  /// Moves the content of `x` into the queued message with the same key, if
+  /// present. Otherwise, remembers `x` as latest message for its key.
+  /// @returns `true` if the caller must drop `x`, `false` otherwise.
+  bool conflate(mailbox_element& x);
+
+  /// Forgets `x` if it is the latest message for its key. Must be called
+  /// before consuming or dropping a message.
+  void erase(const mailbox_element& x);
+
+  /// Forgets all messages.
+  void clear() noexcept;
+
+private:
+  struct entry {
+    type_id_list types;
+    key_function fn;
+    std::unordered_map<std::string, mailbox_element*> latest;
+  };
+
+  entry* find(const mailbox_element& x) noexcept;
+
+  std::vector<entry> entries_;
+};
+
+} // namespace caf::detail
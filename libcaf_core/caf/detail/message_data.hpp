@@ -13,6 +13,7 @@
 #include "caf/detail/core_export.hpp"
 #include "caf/detail/implicit_conversions.hpp"
 #include "caf/detail/padded_size.hpp"
+#include "caf/detail/slab_allocator.hpp"
 #include "caf/fwd.hpp"
 #include "caf/type_id_list.hpp"
 
@@ -49,6 +50,14 @@ public:
 
   static intrusive_ptr<message_data> make_uninitialized(type_id_list types);
 
+  /// Allocates memory for a `message_data` object with `storage_size` bytes
+  /// for storing the elements. Messages usually cross thread boundaries, so
+  /// the memory comes from the @ref slab_allocator.
+  /// @returns a pointer to uninitialized memory or `nullptr` on failure.
+  static void* allocate(size_t storage_size) noexcept {
+    return slab_allocator::allocate(sizeof(message_data) + storage_size);
+  }
+
   // -- reference counting -----------------------------------------------------
 
   /// Increases reference count by one.
@@ -61,7 +70,7 @@ public:
   void deref() noexcept {
     if (unique() || rc_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
       this->~message_data();
-      free(const_cast<message_data*>(this));
+      slab_allocator::deallocate(const_cast<message_data*>(this));
     }
   }
 
@@ -18,7 +18,7 @@ class private_thread : public private_thread_pool::node {
 public:
   void resume(resumable* ptr);
 
-  bool stop() override;
+  void stop() override;
 
   static private_thread* launch(actor_system* sys);
 
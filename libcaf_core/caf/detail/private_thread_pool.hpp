@@ -5,25 +5,31 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
-#include <forward_list>
+#include <deque>
 #include <mutex>
 #include <thread>
 
 #include "caf/fwd.hpp"
+#include "caf/timespan.hpp"
 
 namespace caf::detail {
 
+/// Hands out threads for detached actors. Keeps up to `max-idle` threads of
+/// terminated actors around for reuse and stops threads that remain idle for
+/// longer than `idle-timeout` (see `caf.private-threads`).
 class private_thread_pool {
 public:
   struct node {
     virtual ~node();
     node* next = nullptr;
-    // Called by the private thread pool to stop the node. Regular nodes should
-    // return true. Returning false signals the thread pool to shut down.
-    virtual bool stop() = 0;
+    // Called by the private thread pool to stop the node.
+    virtual void stop() = 0;
   };
 
+  using clock_type = std::chrono::steady_clock;
+
   explicit private_thread_pool(actor_system* sys) : sys_(sys), running_(0) {
     // nop
   }
@@ -38,10 +44,25 @@ public:
 
   void release(private_thread*);
 
+  /// Returns the number of acquired threads.
   size_t running() const noexcept;
 
+  /// Returns the number of threads that currently wait for reuse.
+  size_t idle() const noexcept;
+
 private:
-  std::pair<node*, size_t> dequeue();
+  struct idle_thread {
+    private_thread* ptr;
+    clock_type::time_point deadline;
+  };
+
+  // Moves all idle threads that reached their deadline to the list of nodes
+  // that the pool stops next. Requires the caller to hold the lock.
+  void expire(clock_type::time_point now);
+
+  // Adds `ptr` to the list of nodes that the pool stops next. Requires the
+  // caller to hold the lock.
+  void push_stop(node* ptr) noexcept;
 
   actor_system* sys_;
   std::thread loop_;
@@ -49,6 +70,12 @@ private:
   std::condition_variable cv_;
   node* head_ = nullptr;
   size_t running_;
+  bool shutting_down_ = false;
+  size_t max_idle_ = 0;
+  timespan idle_timeout_{0};
+  // Stores idle threads in release order. Acquiring a thread picks the most
+  // recent one, expiring starts at the front.
+  std::deque<idle_thread> idle_;
 };
 
 } // namespace caf::detail
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <type_traits>
 #include <vector>
 
 #include "caf/actor_cast.hpp"
@@ -33,6 +34,37 @@ void profiled_send(Self* self, SelfHandle&& src, const Handle& dst,
   }
 }
 
+template <class Self, class SelfHandle, class Handle, class Container>
+void profiled_send_batch(Self* self, const SelfHandle& src, const Handle& dst,
+                         message_id msg_id, execution_unit* context,
+                         Container&& xs) {
+  if (dst) {
+    mailbox_element_ptr first;
+    mailbox_element* last = nullptr;
+    for (auto& x : xs) {
+      auto element = [&] {
+        if constexpr (std::is_lvalue_reference_v<Container>)
+          return make_mailbox_element(src, msg_id, no_stages, x);
+        else
+          return make_mailbox_element(src, msg_id, no_stages, std::move(x));
+      }();
+      CAF_BEFORE_SENDING(self, *element);
+      if (last == nullptr) {
+        first = std::move(element);
+        last = first.get();
+      } else {
+        last->next = element.release();
+        last = static_cast<mailbox_element*>(last->next);
+      }
+    }
+    if (first)
+      dst->enqueue_batch(std::move(first), context);
+  } else {
+    auto n = static_cast<int64_t>(xs.size());
+    self->home_system().base_metrics().rejected_messages->inc(n);
+  }
+}
+
 template <class Self, class SelfHandle, class Handle, class... Ts>
 disposable profiled_send(Self* self, SelfHandle&& src, const Handle& dst,
                          actor_clock& clock, actor_clock::time_point timeout,
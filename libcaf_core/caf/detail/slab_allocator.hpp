@@ -0,0 +1,100 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+#include "caf/detail/core_export.hpp"
+
+// Pooling memory hides use-after-free bugs from the address sanitizer.
+#if defined(__SANITIZE_ADDRESS__)
+#  define CAF_SLAB_ALLOCATOR_USE_HEAP
+#elif defined(__has_feature)
+#  if __has_feature(address_sanitizer)
+#    define CAF_SLAB_ALLOCATOR_USE_HEAP
+#  endif
+#endif
+
+namespace caf::detail {
+
+/// Allocates small blocks of memory from size-classed pools that each thread
+/// keeps for itself. CAF uses this allocator for mailbox elements and message
+/// data, i.e., for objects that one thread usually allocates and another
+/// thread releases.
+///
+/// Allocating and releasing a block on the thread that allocated it only
+/// accesses a thread-local free list. Releasing a block on another thread adds
+/// the block to a thread-local batch. Once the batch is full, the allocator
+/// returns all blocks of the batch to their owner with a single CAS operation.
+/// The owner picks up returned blocks when running out of blocks on its free
+/// list. Larger blocks go to the regular heap.
+///
+/// The allocator never returns memory of its pools to the operating system,
+/// since a slab becomes free only after all of its blocks return, which rarely
+/// happens once blocks travel between threads. Hence, the memory that the
+/// pools reserve matches the peak number of blocks in flight. When a thread
+/// terminates, the next new thread adopts its pools.
+class CAF_CORE_EXPORT slab_allocator {
+public:
+  /// Summarizes the activity of the allocator.
+  struct statistics {
+    /// Number of allocations served from a thread-local free list.
+    size_t hits;
+
+    /// Number of times a thread picked up blocks that other threads returned.
+    size_t refills;
+
+    /// Number of allocations that had to take a fresh block from a pool.
+    size_t misses;
+
+    /// Number of allocations that went to the regular heap.
+    size_t heap_allocations;
+
+    /// Number of blocks released by a thread other than their owner.
+    size_t remote_frees;
+
+    /// Number of bytes that the pools reserved from the regular heap.
+    size_t reserved_bytes;
+  };
+
+  /// Stores whether the allocator uses its pools. Builds with the address
+  /// sanitizer always allocate from the regular heap.
+#ifdef CAF_SLAB_ALLOCATOR_USE_HEAP
+  static constexpr bool enabled = false;
+#else
+  static constexpr bool enabled = true;
+#endif
+
+  /// Largest block size in bytes that the pools serve.
+  static constexpr size_t max_block_size = 512;
+
+  /// Allocates `size` bytes, aligned to `alignof(std::max_align_t)`.
+  /// @returns a pointer to the new block or `nullptr` on failure.
+  static void* allocate(size_t size) noexcept;
+
+  /// Allocates two blocks of `first_size` and `second_size` bytes with a
+  /// single allocation. Both blocks are aligned to
+  /// `alignof(std::max_align_t)` and callers release each block individually
+  /// with `deallocate`. The allocator reclaims the memory after releasing both
+  /// blocks, in any order and on any thread.
+  /// @returns pointers to the two blocks or two `nullptr` on failure.
+  static std::pair<void*, void*> allocate_pair(size_t first_size,
+                                               size_t second_size) noexcept;
+
+  /// Releases a block previously returned by `allocate` or `allocate_pair`.
+  static void deallocate(void* ptr) noexcept;
+
+  /// Returns all blocks that the calling thread has released on behalf of
+  /// other threads to their owners without waiting for full batches.
+  static void flush() noexcept;
+
+  /// Returns the sum of all counters over all threads. Since threads update
+  /// their counters without synchronization, the result is approximate while
+  /// other threads allocate memory.
+  static statistics stats() noexcept;
+};
+
+} // namespace caf::detail
@@ -75,16 +75,14 @@ public:
     // nop
   }
 
-  void operator()(actor_system& sys, std::unique_lock<std::shared_mutex>& ulock,
-                  const std::vector<actor>& workers, mailbox_element_ptr& ptr,
-                  execution_unit* host) {
+  void operator()(actor_system& sys, const std::vector<actor>& workers,
+                  mailbox_element_ptr& ptr, execution_unit* host) {
     if (!ptr->sender)
       return;
     actor_msg_vec xs;
     xs.reserve(workers.size());
     for (const auto& worker : workers)
       xs.emplace_back(worker, message{});
-    ulock.unlock();
     using collector_t = split_join_collector<T, Split, Join>;
     auto hdl = sys.spawn<collector_t, lazy_init>(init_, sf_, jf_,
                                                  std::move(xs));
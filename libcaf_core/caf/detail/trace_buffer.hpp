@@ -0,0 +1,154 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/config.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "caf/detail/core_export.hpp"
+#include "caf/fwd.hpp"
+
+namespace caf::detail {
+
+/// Denotes the type of a @ref trace_event.
+enum class trace_event_type : uint8_t {
+  /// A worker starts running a job. The value is the ID of the actor or 0.
+  resume_begin,
+  /// A worker stops running a job. The value is unused.
+  resume_end,
+  /// An actor consumed messages during the current resume. The value is the
+  /// number of consumed messages.
+  messages,
+  /// A worker stole jobs from another worker. The value is the number of
+  /// stolen jobs.
+  steal,
+  /// A worker goes to sleep, because it found no work. The value is unused.
+  park,
+  /// A worker wakes up after parking. The value is unused.
+  unpark,
+};
+
+/// A fixed-size record in a @ref trace_buffer.
+struct trace_event {
+  /// Nanoseconds since the epoch of the steady clock.
+  int64_t timestamp;
+
+  /// Type-dependent payload.
+  uint64_t value;
+
+  /// Selects the type of this event.
+  trace_event_type type;
+};
+
+/// A bounded single-producer, single-consumer ring buffer for trace events.
+/// Each worker owns one buffer and a background thread drains all buffers.
+///
+/// Pushing never blocks and never allocates. If the consumer falls behind, the
+/// buffer drops new events and counts them instead.
+class CAF_CORE_EXPORT trace_buffer {
+public:
+  /// Creates a buffer for the thread `id` that holds at least `capacity`
+  /// events.
+  trace_buffer(size_t id, size_t capacity) : id_(id) {
+    // Round up to the next power of two.
+    size_t size = 2;
+    while (size < capacity)
+      size <<= 1;
+    mask_ = size - 1;
+    events_ = std::make_unique<trace_event[]>(size);
+  }
+
+  trace_buffer(const trace_buffer&) = delete;
+
+  trace_buffer& operator=(const trace_buffer&) = delete;
+
+  /// Returns the ID of the thread that writes to this buffer.
+  size_t id() const noexcept {
+    return id_;
+  }
+
+  /// Returns the maximum number of events in the buffer.
+  size_t capacity() const noexcept {
+    return mask_ + 1;
+  }
+
+  /// Returns the number of dropped events.
+  size_t dropped() const noexcept {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+
+  /// Returns the current time for timestamps.
+  static int64_t now() noexcept {
+    using namespace std::chrono;
+    auto t = steady_clock::now().time_since_epoch();
+    return duration_cast<nanoseconds>(t).count();
+  }
+
+  // -- for the producer -------------------------------------------------------
+
+  /// Appends an event with the current time or drops it if the buffer is full.
+  void push(trace_event_type type, uint64_t value = 0) noexcept {
+    auto tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_cache_ > mask_) {
+      head_cache_ = head_.load(std::memory_order_acquire);
+      if (tail - head_cache_ > mask_) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+    }
+    auto& slot = events_[tail & mask_];
+    slot.timestamp = now();
+    slot.value = value;
+    slot.type = type;
+    tail_.store(tail + 1, std::memory_order_release);
+  }
+
+  /// Appends a `resume_begin` event for `job`.
+  void push_resume_begin(resumable* job) noexcept;
+
+  // -- for the consumer -------------------------------------------------------
+
+  /// Calls `f` for each available event, oldest first, and removes all visited
+  /// events from the buffer.
+  /// @returns the number of visited events.
+  template <class F>
+  size_t drain(F&& f) {
+    auto head = head_.load(std::memory_order_relaxed);
+    auto tail = tail_.load(std::memory_order_acquire);
+    for (auto i = head; i != tail; ++i)
+      f(events_[i & mask_]);
+    head_.store(tail, std::memory_order_release);
+    return tail - head;
+  }
+
+private:
+  /// Index of the next event for the consumer.
+  alignas(CAF_CACHE_LINE_SIZE) std::atomic<size_t> head_ = 0;
+
+  /// Index past the newest event. Only modified by the producer.
+  alignas(CAF_CACHE_LINE_SIZE) std::atomic<size_t> tail_ = 0;
+
+  /// Last value of `head_` seen by the producer.
+  size_t head_cache_ = 0;
+
+  /// Counts events that did not fit into the buffer.
+  std::atomic<size_t> dropped_ = 0;
+
+  /// Stores `capacity - 1`, where capacity is a power of two.
+  alignas(CAF_CACHE_LINE_SIZE) size_t mask_;
+
+  /// Thread ID for the trace output.
+  size_t id_;
+
+  /// Circular array of events.
+  std::unique_ptr<trace_event[]> events_;
+};
+
+} // namespace caf::detail
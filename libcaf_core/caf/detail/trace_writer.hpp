@@ -0,0 +1,88 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include <condition_variable>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "caf/detail/core_export.hpp"
+#include "caf/detail/trace_buffer.hpp"
+#include "caf/fwd.hpp"
+#include "caf/timespan.hpp"
+
+namespace caf::detail {
+
+/// Drains a set of @ref trace_buffer instances in the background and writes
+/// their events to a file in the JSON format of the Chrome trace viewer, which
+/// Perfetto can open as well.
+class CAF_CORE_EXPORT trace_writer {
+public:
+  /// Creates a writer for `path` that periodically drains all buffers.
+  /// @param path Output file.
+  /// @param process_name Name of the traced component in the output.
+  /// @param buffer_size Capacity for each new buffer.
+  /// @param interval Time between two runs of the background thread.
+  trace_writer(std::string path, std::string process_name, size_t buffer_size,
+               timespan interval);
+
+  trace_writer(const trace_writer&) = delete;
+
+  trace_writer& operator=(const trace_writer&) = delete;
+
+  ~trace_writer();
+
+  /// Opens the output file and launches the background thread.
+  /// @returns `false` if the writer failed to open the output file.
+  bool start(actor_system& sys);
+
+  /// Drains all buffers one last time, completes the output file and stops the
+  /// background thread.
+  void stop();
+
+  /// Creates a new buffer for the thread `id`. The writer keeps ownership of
+  /// the buffer until it gets destroyed.
+  trace_buffer* make_buffer(size_t id, std::string thread_name);
+
+  /// Returns the number of events that did not fit into their buffer.
+  size_t dropped() const;
+
+private:
+  struct entry {
+    std::unique_ptr<trace_buffer> buf;
+    std::string thread_name;
+    // Stores whether the output already contains the thread name.
+    bool announced = false;
+    // Messages consumed in the current resume, reported at its end.
+    uint64_t messages = 0;
+  };
+
+  void run();
+
+  // Writes all pending events. Requires holding the lock on `mtx_`.
+  void drain();
+
+  void write(const trace_event& event, entry& state);
+
+  void begin_event();
+
+  std::string path_;
+  std::string process_name_;
+  size_t buffer_size_;
+  timespan interval_;
+  mutable std::mutex mtx_;
+  std::condition_variable cv_;
+  bool stopped_ = false;
+  std::vector<entry> buffers_;
+  std::ofstream out_;
+  bool first_ = true;
+  std::thread thread_;
+};
+
+} // namespace caf::detail
@@ -264,8 +264,12 @@ struct callable_trait<R(Ts...)> {
   /// The signature of the function, wrapped into a `std::function`.
   using fun_type = std::function<R(Ts...)>;
 
+  /// Tells whether the function takes rvalue references as argument.
+  static constexpr bool moves_args = (std::is_rvalue_reference_v<Ts> || ...);
+
   /// Tells whether the function takes mutable references as argument.
-  static constexpr bool mutates_args = (is_mutable_ref<Ts>::value || ...);
+  static constexpr bool mutates_args = moves_args
+                                       || (is_mutable_ref<Ts>::value || ...);
 
   /// Selects a suitable view type for passing a ::message to this function.
   using message_view_type
@@ -0,0 +1,192 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/config.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace caf::detail {
+
+/// A lock-free, growable work-stealing deque based on the algorithm by Chase
+/// and Lev with the memory orderings from "Correct and Efficient Work-Stealing
+/// for Weak Memory Models" (Lê et al., PPoPP 2013).
+///
+/// Only the owner of the deque may call `push_bottom` and `pop_bottom`. Any
+/// thread may call `steal`. Pushing never uses atomic read-modify-write
+/// operations and popping only needs a CAS when competing with thieves for the
+/// last element.
+///
+/// When growing the circular array, the owner keeps the previous arrays alive
+/// until the deque gets destroyed, since concurrent thieves may still read from
+/// them. Because the capacity doubles on each step, this at most doubles the
+/// memory footprint.
+template <class T>
+class work_stealing_deque {
+public:
+  using value_type = T;
+  using pointer = value_type*;
+
+  static constexpr size_t default_capacity = 64;
+
+  explicit work_stealing_deque(size_t initial_capacity = default_capacity)
+    : top_(0), bottom_(0) {
+    // Round up to the next power of two.
+    size_t capacity = 2;
+    while (capacity < initial_capacity)
+      capacity <<= 1;
+    auto buf = std::make_unique<buffer>(capacity);
+    buf_.store(buf.get(), std::memory_order_relaxed);
+    buffers_.emplace_back(std::move(buf));
+  }
+
+  work_stealing_deque(const work_stealing_deque&) = delete;
+
+  work_stealing_deque& operator=(const work_stealing_deque&) = delete;
+
+  // -- for the owner ----------------------------------------------------------
+
+  /// Pushes `value` to the bottom of the deque.
+  void push_bottom(pointer value) {
+    CAF_ASSERT(value != nullptr);
+    auto b = bottom_.load(std::memory_order_relaxed);
+    auto t = top_.load(std::memory_order_acquire);
+    auto* buf = buf_.load(std::memory_order_relaxed);
+    if (b - t > static_cast<int64_t>(buf->mask))
+      buf = grow(buf, t, b);
+    buf->put(b, value);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(b + 1, std::memory_order_relaxed);
+  }
+
+  /// Removes the most recently pushed element from the bottom of the deque.
+  /// @returns the removed element or `nullptr` if the deque is empty.
+  pointer pop_bottom() {
+    auto b = bottom_.load(std::memory_order_relaxed) - 1;
+    auto* buf = buf_.load(std::memory_order_relaxed);
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto t = top_.load(std::memory_order_relaxed);
+    if (t > b) {
+      // The deque was empty: restore the bottom index.
+      bottom_.store(b + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    auto* result = buf->get(b);
+    if (t == b) {
+      // Last element: race against thieves.
+      if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                        std::memory_order_relaxed))
+        result = nullptr;
+      bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+    return result;
+  }
+
+  // -- for others -------------------------------------------------------------
+
+  /// Tries to remove the oldest element from the top of the deque.
+  /// @returns the removed element or `nullptr` if the deque is empty or if
+  ///          another thread took the element first.
+  pointer steal() {
+    auto t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto b = bottom_.load(std::memory_order_acquire);
+    if (t >= b)
+      return nullptr;
+    auto* result = buf_.load(std::memory_order_acquire)->get(t);
+    if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed))
+      return nullptr;
+    return result;
+  }
+
+  /// Tries to remove up to half of the elements (rounded up) but no more than
+  /// `max_count` from the top of the deque and writes them to `out`, oldest
+  /// element first.
+  /// @note The Chase-Lev algorithm only allows thieves to claim one element at
+  ///       a time without slowing down the owner. Hence, this function claims
+  ///       each element with a separate CAS but stops at the first failure.
+  /// @returns the number of removed elements.
+  template <class OutputIterator>
+  size_t steal_half(size_t max_count, OutputIterator out) {
+    auto count = std::min((size_hint() + 1) / 2, max_count);
+    for (size_t i = 0; i < count; ++i) {
+      auto* value = steal();
+      if (value == nullptr)
+        return i;
+      *out++ = value;
+    }
+    return count;
+  }
+
+  /// Returns an approximation of the number of elements in the deque.
+  size_t size_hint() const noexcept {
+    auto b = bottom_.load(std::memory_order_relaxed);
+    auto t = top_.load(std::memory_order_relaxed);
+    return b > t ? static_cast<size_t>(b - t) : 0u;
+  }
+
+  /// Returns whether the deque appears to be empty.
+  bool empty() const noexcept {
+    return size_hint() == 0;
+  }
+
+  /// Returns the current capacity of the circular array.
+  size_t capacity() const noexcept {
+    return buf_.load(std::memory_order_relaxed)->mask + 1;
+  }
+
+private:
+  struct buffer {
+    explicit buffer(size_t capacity)
+      : mask(capacity - 1), slots(new std::atomic<pointer>[capacity]()) {
+      // nop
+    }
+
+    pointer get(int64_t index) const noexcept {
+      return slots[static_cast<size_t>(index) & mask].load(
+        std::memory_order_relaxed);
+    }
+
+    void put(int64_t index, pointer value) noexcept {
+      slots[static_cast<size_t>(index) & mask].store(value,
+                                                     std::memory_order_relaxed);
+    }
+
+    size_t mask;
+    std::unique_ptr<std::atomic<pointer>[]> slots;
+  };
+
+  buffer* grow(buffer* old_buf, int64_t t, int64_t b) {
+    auto new_buf = std::make_unique<buffer>((old_buf->mask + 1) * 2);
+    for (auto i = t; i != b; ++i)
+      new_buf->put(i, old_buf->get(i));
+    auto* result = new_buf.get();
+    buffers_.emplace_back(std::move(new_buf));
+    buf_.store(result, std::memory_order_release);
+    return result;
+  }
+
+  /// Index of the oldest element. Advanced by thieves and by the owner when
+  /// popping the last element.
+  alignas(CAF_CACHE_LINE_SIZE) std::atomic<int64_t> top_;
+
+  /// Index past the newest element. Only modified by the owner.
+  alignas(CAF_CACHE_LINE_SIZE) std::atomic<int64_t> bottom_;
+
+  /// Points to the current circular array.
+  std::atomic<buffer*> buf_;
+
+  /// Owns the current array plus all arrays that were replaced by `grow`.
+  std::vector<std::unique_ptr<buffer>> buffers_;
+};
+
+} // namespace caf::detail
@@ -0,0 +1,70 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/actor_addr.hpp"
+#include "caf/config.hpp"
+#include "caf/detail/core_export.hpp"
+#include "caf/fwd.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace caf::detail {
+
+/// Publishes which job a worker currently runs and since when, allowing a
+/// watchdog thread to detect workers that got stuck in a single `resume`.
+/// Only the worker writes to this slot. Hence, the slot occupies its own cache
+/// line to keep the watchdog from interfering with other worker state.
+class CAF_CORE_EXPORT worker_activity {
+public:
+  using clock_type = std::chrono::steady_clock;
+
+  /// A consistent snapshot of a worker activity.
+  struct snapshot {
+    /// Identifies the resume operation.
+    uint64_t seq;
+
+    /// Time since epoch of `clock_type` in nanoseconds when the worker started
+    /// running the current job or 0 if the worker is idle.
+    int64_t since;
+
+    /// ID of the actor that the worker runs or 0 for other jobs.
+    actor_id aid;
+  };
+
+  worker_activity() = default;
+
+  worker_activity(const worker_activity&) = delete;
+
+  worker_activity& operator=(const worker_activity&) = delete;
+
+  /// Marks the start of `job->resume(...)`.
+  void begin(resumable* job) noexcept;
+
+  /// Marks the end of the current resume operation.
+  void end() noexcept {
+    since_.store(0, std::memory_order_release);
+  }
+
+  /// Returns a snapshot of this slot or a snapshot with `since == 0` if the
+  /// worker is idle or currently publishing a new job.
+  snapshot read() const noexcept;
+
+  /// Returns the current time in the unit of `snapshot::since`.
+  static int64_t now() noexcept {
+    auto ts = clock_type::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(ts).count();
+  }
+
+private:
+  /// Odd while the worker updates the slot, even otherwise.
+  alignas(CAF_CACHE_LINE_SIZE) std::atomic<uint64_t> seq_ = 0;
+  std::atomic<int64_t> since_ = 0;
+  std::atomic<actor_id> aid_ = 0;
+};
+
+} // namespace caf::detail
@@ -47,9 +47,27 @@ public:
     proxies_ = ptr;
   }
 
+  /// Returns the named scheduler pool of this unit or `nullptr` if this unit
+  /// does not belong to a named scheduler pool.
+  scheduler::abstract_coordinator* pool() const noexcept {
+    return pool_;
+  }
+
+  /// Returns the trace buffer of this unit or `nullptr` if tracing is off.
+  detail::trace_buffer* trace_buffer() const noexcept {
+    return trace_buffer_;
+  }
+
+  /// Associates a trace buffer to this unit.
+  void trace_buffer(detail::trace_buffer* ptr) noexcept {
+    trace_buffer_ = ptr;
+  }
+
 protected:
   actor_system* system_ = nullptr;
   proxy_registry* proxies_ = nullptr;
+  scheduler::abstract_coordinator* pool_ = nullptr;
+  detail::trace_buffer* trace_buffer_ = nullptr;
 };
 
 } // namespace caf
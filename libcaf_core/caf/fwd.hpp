@@ -352,6 +352,7 @@ class message_data;
 class private_thread;
 class stream_bridge;
 class stream_bridge_sub;
+class trace_buffer;
 
 struct meta_object;
 
@@ -4,17 +4,54 @@
 
 #pragma once
 
+#include <algorithm>
 #include <limits>
+#include <type_traits>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "caf/config.hpp"
 
 #include "caf/intrusive/new_round_result.hpp"
 #include "caf/intrusive/task_queue.hpp"
 #include "caf/intrusive/task_result.hpp"
+#include "caf/unit.hpp"
 
 namespace caf::intrusive {
 
+/// Selects the index for the cache of a `drr_cached_queue`. Policies enable
+/// the index by defining `cache_key_type` and a member function `cache_key`
+/// that returns the key of a task.
+/// @private
+template <class Policy, class = void>
+struct drr_cache_index {
+  static constexpr bool enabled = false;
+
+  using type = unit_t;
+};
+
+/// @private
+template <class Policy>
+struct drr_cache_index<Policy, std::void_t<typename Policy::cache_key_type>> {
+  static constexpr bool enabled = true;
+
+  using type = std::unordered_map<typename Policy::cache_key_type,
+                                  typename Policy::task_size_type>;
+};
+
+/// A cache filter for `drr_cached_queue` that retries all cached tasks.
+struct drr_cache_retry_all {
+  constexpr bool retry_all() const noexcept {
+    return true;
+  }
+
+  template <class Key>
+  constexpr bool retry(const Key&) const noexcept {
+    return true;
+  }
+};
+
 /// A Deficit Round Robin queue with an internal cache for allowing skipping
 /// consumers.
 template <class Policy>
@@ -43,6 +80,11 @@ public:
 
   using cache_type = task_queue<policy_type>;
 
+  using cache_index_type = typename drr_cache_index<policy_type>::type;
+
+  /// Stores whether the policy provides keys for indexing the cache.
+  static constexpr bool has_cache_index = drr_cache_index<policy_type>::enabled;
+
   // -- constructors, destructors, and assignment operators -------------------
 
   drr_cached_queue(policy_type p)
@@ -53,14 +95,19 @@ public:
   drr_cached_queue(drr_cached_queue&& other)
     : list_(std::move(other.list_)),
       deficit_(other.deficit_),
-      cache_(std::move(other.cache_)) {
-    // nop
+      cache_(std::move(other.cache_)),
+      cache_index_(std::move(other.cache_index_)),
+      indexed_task_size_(other.indexed_task_size_) {
+    other.indexed_task_size_ = 0;
   }
 
   drr_cached_queue& operator=(drr_cached_queue&& other) {
     list_ = std::move(other.list_);
     deficit_ = other.deficit_;
     cache_ = std::move(other.cache_);
+    cache_index_ = std::move(other.cache_index_);
+    indexed_task_size_ = other.indexed_task_size_;
+    other.indexed_task_size_ = 0;
     return *this;
   }
 
@@ -115,6 +162,7 @@ public:
   void clear() {
     list_.clear();
     cache_.clear();
+    clear_cache_index();
   }
 
   void inc_deficit(deficit_type x) noexcept {
@@ -122,8 +170,38 @@ public:
       deficit_ += x;
   }
 
+  /// Moves all cached tasks back to the front of the queue.
   void flush_cache() noexcept {
     list_.prepend(cache_);
+    clear_cache_index();
+  }
+
+  /// Moves cached tasks back to the front of the queue, preserving their
+  /// order. Moves all tasks if `filter.retry_all()` returns `true`. Otherwise,
+  /// moves only the tasks with a key for which `filter.retry(key)` returns
+  /// `true`. Calls `filter.retry` once per distinct key in the cache and scans
+  /// the cache only if at least one key qualifies.
+  template <class Filter>
+  void flush_cache_if(Filter& filter) noexcept {
+    if (cache_.empty())
+      return;
+    if constexpr (has_cache_index) {
+      // Tasks that bypassed `push_to_cache` are missing in the index.
+      if (!filter.retry_all() && indexed_task_size_ == cache_.total_task_size())
+        return flush_indexed(filter);
+    }
+    flush_cache();
+  }
+
+  /// Appends `ptr` to the cache.
+  /// @pre `ptr != nullptr`
+  void push_to_cache(pointer ptr) noexcept {
+    if constexpr (has_cache_index) {
+      auto ts = policy().task_size(*ptr);
+      cache_index_[policy().cache_key(*ptr)] += ts;
+      indexed_task_size_ += ts;
+    }
+    cache_.push_back(ptr);
   }
 
   /// @private
@@ -168,6 +246,17 @@ public:
   /// Run a new round with `quantum`, dispatching all tasks to `consumer`.
   template <class F>
   new_round_result new_round(deficit_type quantum, F& consumer) noexcept(
+    noexcept(consumer(std::declval<value_type&>()))) {
+    drr_cache_retry_all filter;
+    return new_round(quantum, consumer, filter);
+  }
+
+  /// Run a new round with `quantum`, dispatching all tasks to `consumer`.
+  /// After each consumed task, passes `filter` to `flush_cache_if` for
+  /// deciding which skipped tasks to retry.
+  template <class F, class Filter>
+  new_round_result
+  new_round(deficit_type quantum, F& consumer, Filter& filter) noexcept(
     noexcept(consumer(std::declval<value_type&>()))) {
     if (list_.empty())
       return {0, false};
@@ -183,7 +272,7 @@ public:
           // Fix deficit counter since we didn't actually use it.
           deficit_ += policy().task_size(*ptr);
           // Push the unconsumed item to the cache.
-          cache_.push_back(ptr.release());
+          push_to_cache(ptr.release());
           if (list_.empty()) {
             deficit_ = 0;
             return {consumed, false};
@@ -191,7 +280,7 @@ public:
           break;
         case task_result::resume:
           ++consumed;
-          flush_cache();
+          flush_cache_if(filter);
           if (list_.empty()) {
             deficit_ = 0;
             return {consumed, false};
@@ -199,7 +288,7 @@ public:
           break;
         default:
           ++consumed;
-          flush_cache();
+          flush_cache_if(filter);
           if (list_.empty())
             deficit_ = 0;
           return {consumed, consumer_res == task_result::stop_all};
@@ -248,6 +337,57 @@ public:
   }
 
 private:
+  // -- cache management ------------------------------------------------------
+
+  void clear_cache_index() noexcept {
+    if constexpr (has_cache_index) {
+      cache_index_.clear();
+      indexed_task_size_ = 0;
+    }
+  }
+
+  template <class Filter>
+  void flush_indexed(Filter& filter) noexcept {
+    using key_type = typename policy_type::cache_key_type;
+    // Pick all keys to retry.
+    std::vector<key_type> keys;
+    task_size_type pending = 0;
+    for (auto i = cache_index_.begin(); i != cache_index_.end();) {
+      if (filter.retry(i->first)) {
+        keys.emplace_back(i->first);
+        pending += i->second;
+        i = cache_index_.erase(i);
+      } else {
+        ++i;
+      }
+    }
+    if (keys.empty())
+      return;
+    if (cache_index_.empty()) {
+      flush_cache();
+      return;
+    }
+    // Move all tasks with a selected key to `retry`. We can stop as soon as we
+    // found all of them.
+    indexed_task_size_ -= pending;
+    cache_type keep{policy()};
+    cache_type retry{policy()};
+    while (pending > 0 && !cache_.empty()) {
+      auto dummy_deficit = std::numeric_limits<deficit_type>::max();
+      auto ptr = cache_.next(dummy_deficit);
+      auto key = policy().cache_key(*ptr);
+      if (std::find(keys.begin(), keys.end(), key) != keys.end()) {
+        pending -= policy().task_size(*ptr);
+        retry.push_back(ptr.release());
+      } else {
+        keep.push_back(ptr.release());
+      }
+    }
+    keep.append(cache_);
+    cache_ = std::move(keep);
+    list_.prepend(retry);
+  }
+
   // -- member variables ------------------------------------------------------
   /// Stores current (unskipped) items.
   list_type list_;
@@ -257,6 +397,12 @@ private:
 
   /// Stores previously skipped items.
   cache_type cache_;
+
+  /// Maps the keys of cached tasks to their accumulated size.
+  cache_index_type cache_index_;
+
+  /// Stores the accumulated size of all tasks in the index.
+  task_size_type indexed_task_size_ = 0;
 };
 
 } // namespace caf::intrusive
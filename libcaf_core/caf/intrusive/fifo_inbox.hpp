@@ -86,6 +86,30 @@ public:
     return push_back(ptr.release());
   }
 
+  /// Appends the chain of elements that starts at `first`, i.e., `first` and
+  /// all of its successors via `next`, with a single atomic operation.
+  /// @returns `queue_closed` without taking ownership of the elements if the
+  ///          inbox is closed.
+  inbox_result push_back_chain(pointer first) noexcept {
+    CAF_ASSERT(first != nullptr);
+    // The inbox stores its elements in LIFO order.
+    auto reverse = [](node_pointer head) {
+      node_pointer prev = nullptr;
+      while (head != nullptr) {
+        auto next = head->next;
+        head->next = prev;
+        prev = head;
+        head = next;
+      }
+      return prev;
+    };
+    auto newest = reverse(first);
+    auto res = inbox_.push_front_chain(lifo_inbox_type::promote(newest), first);
+    if (res == inbox_result::queue_closed)
+      reverse(newest);
+    return res;
+  }
+
   template <class... Ts>
   inbox_result emplace_back(Ts&&... xs) {
     return push_back(new value_type(std::forward<Ts>(xs)...));
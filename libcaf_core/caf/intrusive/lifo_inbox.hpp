@@ -71,6 +71,30 @@ public:
     return push_front(x.release());
   }
 
+  /// Tries to enqueue the chain of elements from `first` to `last` with a
+  /// single atomic operation. The elements must form a chain via `next`,
+  /// starting at the newest element `first`.
+  /// @returns `queue_closed` without taking ownership of the elements if the
+  ///          inbox is closed.
+  /// @threadsafe
+  inbox_result push_front_chain(pointer first, pointer last) noexcept {
+    CAF_ASSERT(first != nullptr);
+    CAF_ASSERT(last != nullptr);
+    pointer e = stack_.load();
+    auto eof = stack_closed_tag();
+    auto blk = reader_blocked_tag();
+    while (e != eof) {
+      // A tag is never part of a non-empty list.
+      last->next = e != blk ? e : nullptr;
+      if (stack_.compare_exchange_strong(e, first))
+        return e == reader_blocked_tag() ? inbox_result::unblocked_reader
+                                         : inbox_result::success;
+      // Continue with new value of `e`.
+    }
+    last->next = nullptr;
+    return inbox_result::queue_closed;
+  }
+
   /// Tries to enqueue a new element to the mailbox.
   /// @threadsafe
   template <class... Ts>
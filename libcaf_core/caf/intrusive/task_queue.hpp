@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <utility>
 
 #include "caf/config.hpp"
@@ -135,6 +136,30 @@ public:
 
   // -- modifiers -------------------------------------------------------------
 
+  /// Deletes all elements after `pos` for which `pred` returns `true`. Visits
+  /// all elements if `pos` is `nullptr`.
+  /// @returns the number of deleted elements.
+  template <class Predicate>
+  size_t erase_after_if(pointer pos, Predicate pred) {
+    node_pointer prev = pos != nullptr ? pos : &head_;
+    size_t result = 0;
+    for (auto i = prev->next; i != &tail_; i = prev->next) {
+      auto ptr = promote(i);
+      if (pred(*ptr)) {
+        prev->next = i->next;
+        if (tail_.next == i)
+          tail_.next = prev;
+        dec_total_task_size(*ptr);
+        typename unique_pointer::deleter_type d;
+        d(ptr);
+        ++result;
+      } else {
+        prev = i;
+      }
+    }
+    return result;
+  }
+
   /// Removes all elements from the queue.
   void clear() {
     deinit();
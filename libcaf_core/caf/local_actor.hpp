@@ -5,9 +5,11 @@
 #pragma once
 
 #include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <exception>
 #include <functional>
+#include <memory>
 #include <type_traits>
 #include <utility>
 
@@ -21,6 +23,7 @@
 #include "caf/check_typed_input.hpp"
 #include "caf/delegated.hpp"
 #include "caf/detail/core_export.hpp"
+#include "caf/detail/mailbox_bound.hpp"
 #include "caf/detail/type_traits.hpp"
 #include "caf/detail/typed_actor_util.hpp"
 #include "caf/detail/unique_function.hpp"
@@ -61,6 +64,13 @@ public:
 
     /// Counts how many messages are currently waiting in the mailbox.
     telemetry::int_gauge* mailbox_size = nullptr;
+
+    /// Counts how many responses the actor currently waits for.
+    telemetry::int_gauge* pending_requests = nullptr;
+
+    /// Selects on average one in `sample_rate` messages for measuring
+    /// `mailbox_time` and `processing_time`.
+    size_t sample_rate = 1;
   };
 
   /// Optional metrics for inbound stream traffic collected by individual actors
@@ -389,6 +399,15 @@ public:
     return metrics_.processing_time != nullptr;
   }
 
+  /// Stamps `x` with the current time if the actor samples `x` for its
+  /// metrics and clears the timestamp otherwise.
+  /// @pre `has_metrics_enabled()`
+  void sample_enqueue_time(mailbox_element& x) noexcept;
+
+  void track_queued_messages() override;
+
+  size_t queued_messages() const noexcept override;
+
   template <class ActorHandle>
   ActorHandle eval_opts(spawn_options opts, ActorHandle res) {
     if (has_monitor_flag(opts))
@@ -432,6 +451,34 @@ public:
   /// @endcond
 
 protected:
+  // -- bounded mailboxes ------------------------------------------------------
+
+  /// Reserves a slot in the bounded mailbox for `x` or drops `x` according to
+  /// the overflow policy. Responses and urgent messages always get a slot.
+  /// @returns `false` if the actor dropped `x`.
+  /// @pre `mailbox_bound_ != nullptr`
+  bool reserve_mailbox_slot(const mailbox_element& x);
+
+  /// Releases `n` slots of the bounded mailbox.
+  void release_mailbox_slots(size_t n = 1) noexcept {
+    if (mailbox_bound_)
+      mailbox_bound_->release(n);
+    if (tracks_queued_messages_.load(std::memory_order_relaxed))
+      queued_messages_.fetch_sub(static_cast<ptrdiff_t>(n),
+                                 std::memory_order_relaxed);
+  }
+
+  /// Counts `n` new messages in the mailbox if the actor tracks its queued
+  /// messages. Must be called before pushing the messages to the mailbox.
+  void count_queued_messages(size_t n = 1) noexcept {
+    if (tracks_queued_messages_.load(std::memory_order_relaxed))
+      queued_messages_.fetch_add(static_cast<ptrdiff_t>(n),
+                                 std::memory_order_relaxed);
+  }
+
+  /// Counts `n` messages that the actor dropped from its bounded mailbox.
+  void count_dropped_messages(size_t n = 1);
+
   // -- member variables -------------------------------------------------------
 
   // identifies the execution unit this actor is currently executed by
@@ -447,6 +494,16 @@ protected:
   detail::unique_function<behavior(local_actor*)> initial_behavior_fac_;
 
   metrics_t metrics_;
+
+  /// Limits the number of messages in the mailbox, if configured.
+  std::unique_ptr<detail::mailbox_bound> mailbox_bound_;
+
+  /// Enables `queued_messages_`.
+  std::atomic<bool> tracks_queued_messages_ = false;
+
+  /// Approximates the number of messages in the mailbox. May briefly drop
+  /// below zero for messages that arrived before enabling the counter.
+  std::atomic<ptrdiff_t> queued_messages_ = 0;
 };
 
 } // namespace caf
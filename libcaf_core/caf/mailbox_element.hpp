@@ -7,12 +7,16 @@
 #include <chrono>
 #include <cstddef>
 #include <memory>
+#include <new>
 
 #include "caf/actor_control_block.hpp"
 #include "caf/detail/core_export.hpp"
+#include "caf/detail/scope_guard.hpp"
+#include "caf/detail/slab_allocator.hpp"
 #include "caf/intrusive/singly_linked.hpp"
 #include "caf/message.hpp"
 #include "caf/message_id.hpp"
+#include "caf/raise_error.hpp"
 #include "caf/tracing_data.hpp"
 
 namespace caf {
@@ -42,7 +46,9 @@ public:
   /// Stores the payload.
   message payload;
 
-  /// Stores a timestamp for when this element got enqueued.
+  /// Stores a timestamp for when this element got enqueued. Actors that
+  /// sample their metrics leave this field default-constructed for messages
+  /// that they do not sample.
   std::chrono::steady_clock::time_point enqueue_time;
 
   /// Sets `enqueue_time` to the current time.
@@ -50,6 +56,16 @@ public:
     enqueue_time = std::chrono::steady_clock::now();
   }
 
+  /// Resets `enqueue_time` to mark this element as not sampled.
+  void clear_enqueue_time() noexcept {
+    enqueue_time = std::chrono::steady_clock::time_point{};
+  }
+
+  /// Checks whether `enqueue_time` stores a timestamp.
+  bool has_enqueue_time() const noexcept {
+    return enqueue_time != std::chrono::steady_clock::time_point{};
+  }
+
   /// Returns the time between enqueueing the message and `t`.
   double seconds_until(std::chrono::steady_clock::time_point t) const {
     namespace ch = std::chrono;
@@ -72,6 +88,15 @@ public:
     return mid.category() == message_id::urgent_message_category;
   }
 
+  // -- memory management ------------------------------------------------------
+
+  /// Allocates mailbox elements from the @ref detail::slab_allocator, since
+  /// the receiver usually releases elements on another thread. Elements from
+  /// `make_mailbox_element` share a single allocation with their payload.
+  static void* operator new(size_t size);
+
+  static void operator delete(void* ptr) noexcept;
+
   mailbox_element(mailbox_element&&) = delete;
   mailbox_element(const mailbox_element&) = delete;
   mailbox_element& operator=(mailbox_element&&) = delete;
@@ -107,6 +132,8 @@ CAF_CORE_EXPORT mailbox_element_ptr
 make_mailbox_element(strong_actor_ptr sender, message_id id,
                      mailbox_element::forwarding_stack stages, message content);
 
+/// Creates a mailbox element and its payload with a single allocation. The
+/// payload may outlive the element, e.g., after forwarding the message.
 /// @relates mailbox_element
 template <class T, class... Ts>
 std::enable_if_t<!std::is_same<typename std::decay<T>::type, message>::value
@@ -115,9 +142,18 @@ std::enable_if_t<!std::is_same<typename std::decay<T>::type, message>::value
 make_mailbox_element(strong_actor_ptr sender, message_id id,
                      mailbox_element::forwarding_stack stages, T&& x,
                      Ts&&... xs) {
-  return make_mailbox_element(std::move(sender), id, std::move(stages),
-                              make_message(std::forward<T>(x),
-                                           std::forward<Ts>(xs)...));
+  using detail::slab_allocator;
+  auto mem = slab_allocator::allocate_pair(
+    sizeof(mailbox_element), detail::message_data_size_v<T, Ts...>);
+  if (mem.first == nullptr)
+    CAF_RAISE_ERROR(std::bad_alloc, "bad_alloc");
+  auto guard = detail::make_scope_guard(
+    [ptr = mem.first] { slab_allocator::deallocate(ptr); });
+  auto payload = detail::make_message_at(mem.second, std::forward<T>(x),
+                                         std::forward<Ts>(xs)...);
+  guard.disable();
+  return mailbox_element_ptr{::new (mem.first) mailbox_element(
+    std::move(sender), id, std::move(stages), std::move(payload))};
 }
 
 } // namespace caf
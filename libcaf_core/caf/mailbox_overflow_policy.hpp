@@ -0,0 +1,50 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/default_enum_inspect.hpp"
+#include "caf/detail/core_export.hpp"
+
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace caf {
+
+/// Selects what an actor with a bounded mailbox does with messages that
+/// arrive while its mailbox is full.
+enum class mailbox_overflow_policy {
+  /// Silently drops the new message.
+  drop_newest,
+  /// Silently drops the oldest message in the mailbox. The actor drops old
+  /// messages before processing its next batch of messages. Hence, the mailbox
+  /// may exceed its capacity temporarily.
+  drop_oldest,
+  /// Drops the new message and responds to requests with `sec::mailbox_full`.
+  reject,
+  /// Blocks senders that run in their own thread, i.e., blocking actors and
+  /// scoped actors, until the mailbox has room again. Rejects messages from
+  /// all other senders.
+  block,
+};
+
+/// @relates mailbox_overflow_policy
+CAF_CORE_EXPORT std::string to_string(mailbox_overflow_policy);
+
+/// @relates mailbox_overflow_policy
+CAF_CORE_EXPORT bool from_string(std::string_view, mailbox_overflow_policy&);
+
+/// @relates mailbox_overflow_policy
+CAF_CORE_EXPORT bool
+from_integer(std::underlying_type_t<mailbox_overflow_policy>,
+             mailbox_overflow_policy&);
+
+/// @relates mailbox_overflow_policy
+template <class Inspector>
+bool inspect(Inspector& f, mailbox_overflow_policy& x) {
+  return default_enum_inspect(f, x);
+}
+
+} // namespace caf
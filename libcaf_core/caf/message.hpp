@@ -202,24 +202,41 @@ inline message make_message() {
   return {};
 }
 
-/// @relates message
+namespace detail {
+
+/// Stores how many bytes a `message_data` object needs for storing `Ts`.
 template <class... Ts>
-message make_message(Ts&&... xs) {
-  using namespace detail;
+constexpr size_t message_data_size_v
+  = sizeof(message_data) + (padded_size_v<strip_and_convert_t<Ts>> + ...);
+
+/// Constructs a message from `xs` in the uninitialized memory at `vptr`. The
+/// memory must hold at least `message_data_size_v<Ts...>` bytes and come from
+/// the @ref slab_allocator.
+template <class... Ts>
+message make_message_at(void* vptr, Ts&&... xs) {
   static_assert((!std::is_pointer<strip_and_convert_t<Ts>>::value && ...));
   static_assert((is_complete<type_id<strip_and_convert_t<Ts>>> && ...));
-  static constexpr size_t data_size
-    = sizeof(message_data) + (padded_size_v<strip_and_convert_t<Ts>> + ...);
   auto types = make_type_id_list<strip_and_convert_t<Ts>...>();
-  auto vptr = malloc(data_size);
-  if (vptr == nullptr)
-    CAF_RAISE_ERROR(std::bad_alloc, "bad_alloc");
   auto raw_ptr = new (vptr) message_data(types);
   intrusive_cow_ptr<message_data> ptr{raw_ptr, false};
   raw_ptr->init(std::forward<Ts>(xs)...);
   return message{std::move(ptr)};
 }
 
+} // namespace detail
+
+/// @relates message
+template <class... Ts>
+message make_message(Ts&&... xs) {
+  using namespace detail;
+  static constexpr size_t storage_size
+    = message_data_size_v<Ts...> - sizeof(message_data);
+  auto vptr = message_data::allocate(storage_size);
+  if (vptr == nullptr)
+    CAF_RAISE_ERROR(std::bad_alloc, "bad_alloc");
+  return make_message_at(vptr, std::forward<Ts>(xs)...);
+}
+
 /// @relates message
 template <class Tuple, size_t... Is>
 message make_message_from_tuple(Tuple&& xs, std::index_sequence<Is...>) {
@@ -80,6 +80,26 @@ public:
                           self->context(), std::forward<Ts>(xs)...);
   }
 
+  /// Sends each element of `xs` as a separate asynchronous message to `dest`
+  /// with priority `P`. Other than calling `send` in a loop, this function
+  /// adds all messages to the mailbox of `dest` at once and schedules `dest`
+  /// at most once.
+  template <message_priority P = message_priority::normal, class Dest,
+            class Container>
+  detail::enable_if_t<!std::is_same<group, Dest>::value>
+  send_batch(const Dest& dest, Container&& xs) {
+    using value_type = typename std::decay_t<Container>::value_type;
+    static_assert(detail::sendable<value_type>,
+                  "the element type has no ID, "
+                  "did you forgot to announce it via CAF_ADD_TYPE_ID?");
+    detail::type_list<detail::strip_and_convert_t<value_type>> args_token;
+    type_check(dest, args_token);
+    auto self = dptr();
+    strong_actor_ptr src{self->ctrl()};
+    detail::profiled_send_batch(self, src, dest, make_message_id(P),
+                                self->context(), std::forward<Container>(xs));
+  }
+
   template <message_priority P = message_priority::normal, class Dest = actor,
             class... Ts>
   void anon_send(const Dest& dest, Ts&&... xs) {
@@ -12,11 +12,13 @@
 #include <set>
 #include <string>
 #include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 #include "caf/abstract_actor.hpp"
 #include "caf/actor_addr.hpp"
 #include "caf/actor_cast.hpp"
+#include "caf/default_attachable.hpp"
 #include "caf/detail/core_export.hpp"
 #include "caf/detail/functor_attachable.hpp"
 #include "caf/detail/type_traits.hpp"
@@ -104,16 +106,35 @@ protected:
 
   // -- here be dragons: end of public interface -------------------------------
 
+  // identifies monitors and links of an observer
+  struct observer_key {
+    actor_addr observer;
+    default_attachable::observe_type type;
+
+    bool operator==(const observer_key& other) const noexcept {
+      return observer == other.observer && type == other.type;
+    }
+  };
+
+  struct observer_key_hash {
+    size_t operator()(const observer_key& x) const noexcept {
+      return std::hash<actor_addr>{}(x.observer) * 2 + x.type;
+    }
+  };
+
+  using observer_map
+    = std::unordered_multimap<observer_key, attachable_ptr, observer_key_hash>;
+
   // precondition: `mtx_` is acquired
-  void attach_impl(attachable_ptr& ptr) {
-    ptr->next.swap(attachables_head_);
-    attachables_head_.swap(ptr);
-  }
+  void attach_impl(attachable_ptr& ptr);
 
   // precondition: `mtx_` is acquired
   size_t detach_impl(const attachable::token& what, bool stop_on_hit = false,
                      bool dry_run = false);
 
+  // sends a single down_msg and exit_msg to all monitors and links
+  void notify_observers(observer_map& observers, execution_unit* host);
+
   // handles only `exit_msg` and `sys_atom` messages;
   // returns true if the message is handled
   bool handle_system_message(mailbox_element& x, execution_unit* ctx,
@@ -138,9 +159,12 @@ protected:
   // only used in blocking and thread-mapped actors
   mutable std::condition_variable cv_;
 
-  // attached functors that are executed on cleanup (monitors, links, etc)
+  // attached functors that are executed on cleanup, except monitors and links
   attachable_ptr attachables_head_;
 
+  // monitors and links, indexed by their observer for detaching in O(1)
+  observer_map observers_;
+
   /// @endcond
 };
 
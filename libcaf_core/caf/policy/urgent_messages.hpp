@@ -7,6 +7,7 @@
 #include "caf/detail/core_export.hpp"
 #include "caf/fwd.hpp"
 #include "caf/mailbox_element.hpp"
+#include "caf/type_id_list.hpp"
 #include "caf/unit.hpp"
 
 namespace caf::policy {
@@ -42,6 +43,15 @@ public:
   static task_size_type task_size(const mailbox_element&) noexcept {
     return 1;
   }
+
+  // -- interface required by drr_cached_queue ---------------------------------
+
+  /// Skipped messages in the cache are indexed by their types.
+  using cache_key_type = type_id_list;
+
+  static type_id_list cache_key(const mailbox_element& x) noexcept {
+    return x.content().types();
+  }
 };
 
 } // namespace caf::policy
@@ -4,82 +4,157 @@
 
 #pragma once
 
-#include <condition_variable>
+#include <atomic>
 #include <cstddef>
-#include <list>
+#include <memory>
 #include <mutex>
+#include <vector>
 
+#include "caf/config.hpp"
 #include "caf/detail/core_export.hpp"
+#include "caf/detail/event_count.hpp"
+#include "caf/detail/trace_buffer.hpp"
 #include "caf/policy/unprofiled.hpp"
 #include "caf/resumable.hpp"
 
 namespace caf::policy {
 
-/// Implements scheduling of actors via work sharing (central job queue).
+/// Implements scheduling of actors via work sharing (central job queue). The
+/// central queue consists of one shard per worker to avoid contention on a
+/// single lock. Workers enqueue to their own shard and dequeue from their own
+/// shard first, falling back to the other shards before parking.
 /// @extends scheduler_policy
 class CAF_CORE_EXPORT work_sharing : public unprofiled {
 public:
-  // A thread-safe queue implementation.
-  using queue_type = std::list<resumable*>;
+  // A thread-safe FIFO queue that stores its jobs in a growable ring buffer to
+  // avoid allocating memory for each job.
+  class CAF_CORE_EXPORT shard {
+  public:
+    shard() = default;
+
+    shard(const shard&) = delete;
+
+    shard& operator=(const shard&) = delete;
+
+    void push(resumable* job);
+
+    resumable* try_pop();
+
+    // Returns the number of jobs without acquiring the lock.
+    size_t size_hint() const noexcept {
+      return size_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    alignas(CAF_CACHE_LINE_SIZE) std::mutex lock_;
+    std::vector<resumable*> buf_;
+    size_t head_ = 0;
+    std::atomic<size_t> size_ = 0;
+  };
+
+  // A sharded queue implementation.
+  using queue_type = std::vector<std::unique_ptr<shard>>;
 
   ~work_sharing() override;
 
   struct coordinator_data {
-    explicit coordinator_data(scheduler::abstract_coordinator*) {
-      // nop
-    }
+    explicit coordinator_data(scheduler::abstract_coordinator* p);
 
+    // Shards of the central job queue.
     queue_type queue;
-    std::mutex lock;
-    std::condition_variable cv;
+
+    // Assigns shards for jobs from non-worker threads in round-robin order.
+    std::atomic<size_t> next_shard;
+
+    // Parks idle workers until new jobs arrive.
+    detail::event_count idle_workers;
   };
 
   struct worker_data {
-    explicit worker_data(scheduler::abstract_coordinator*) {
+    explicit worker_data(scheduler::abstract_coordinator*) : ticks(0) {
       // nop
     }
+
+    // Counts dequeue operations for periodically scanning all shards.
+    size_t ticks;
   };
 
+  // Scan all shards in round-robin order every X dequeue operations to make
+  // sure that busy workers cannot starve jobs in their own shard.
+  static constexpr size_t fairness_interval = 61;
+
   template <class Coordinator>
-  bool enqueue(Coordinator* self, resumable* job) {
-    queue_type l;
-    l.push_back(job);
-    std::unique_lock<std::mutex> guard(d(self).lock);
-    d(self).queue.splice(d(self).queue.end(), l);
-    d(self).cv.notify_one();
-    return true;
+  void enqueue(Coordinator* self, size_t shard_id, resumable* job) {
+    auto& data = d(self);
+    data.queue[shard_id % data.queue.size()]->push(job);
+    data.idle_workers.notify_one();
   }
 
   template <class Coordinator>
   void central_enqueue(Coordinator* self, resumable* job) {
-    enqueue(self, job);
+    enqueue(self, d(self).next_shard++, job);
   }
 
   template <class Worker>
   void external_enqueue(Worker* self, resumable* job) {
-    enqueue(self->parent(), job);
+    auto p = self->parent();
+    if (p->worker_by_id(self->id()) == self) {
+      enqueue(p, self->id(), job);
+      return;
+    }
+    // a stand-in for a stalled worker only receives its retire job this way,
+    // which other workers pass on until the stand-in picks it up
+    auto& data = d(p);
+    data.queue[self->id() % data.queue.size()]->push(job);
+    data.idle_workers.notify_all();
   }
 
   template <class Worker>
   void internal_enqueue(Worker* self, resumable* job) {
-    enqueue(self->parent(), job);
+    enqueue(self->parent(), self->id(), job);
   }
 
   template <class Worker>
   void resume_job_later(Worker* self, resumable* job) {
     // job has voluntarily released the CPU to let others run instead
     // this means we are going to put this job to the very end of our queue
-    enqueue(self->parent(), job);
+    enqueue(self->parent(), self->id(), job);
+  }
+
+  // Checks all shards for a job, starting at `first`.
+  template <class Coordinator>
+  resumable* try_find_job(Coordinator* self, size_t first) {
+    auto& shards = d(self).queue;
+    auto n = shards.size();
+    for (size_t i = 0; i < n; ++i) {
+      auto& x = *shards[(first + i) % n];
+      if (x.size_hint() == 0)
+        continue;
+      if (auto job = x.try_pop())
+        return job;
+    }
+    return nullptr;
   }
 
   template <class Worker>
   resumable* dequeue(Worker* self) {
-    auto& parent_data = d(self->parent());
-    std::unique_lock<std::mutex> guard(parent_data.lock);
-    parent_data.cv.wait(guard, [&] { return !parent_data.queue.empty(); });
-    resumable* job = parent_data.queue.front();
-    parent_data.queue.pop_front();
-    return job;
+    auto parent = self->parent();
+    auto first = self->id();
+    if (++d(self).ticks % fairness_interval == 0)
+      first += d(self).ticks / fairness_interval;
+    if (auto job = try_find_job(parent, first))
+      return job;
+    auto& idle_workers = d(parent).idle_workers;
+    for (;;) {
+      auto key = idle_workers.prepare_wait();
+      if (auto job = try_find_job(parent, self->id())) {
+        idle_workers.cancel_wait();
+        return job;
+      }
+      self->trace(detail::trace_event_type::park);
+      idle_workers.wait(key);
+      self->trace(detail::trace_event_type::unpark);
+    }
   }
 
   template <class Worker, class UnaryFunction>
@@ -89,19 +164,9 @@ public:
 
   template <class Coordinator, class UnaryFunction>
   void foreach_central_resumable(Coordinator* self, UnaryFunction f) {
-    auto& queue = d(self).queue;
-    auto next = [&]() -> resumable* {
-      if (queue.empty()) {
-        return nullptr;
-      }
-      auto front = queue.front();
-      queue.pop_front();
-      return front;
-    };
-    std::unique_lock<std::mutex> guard(d(self).lock);
-    for (auto job = next(); job != nullptr; job = next()) {
-      f(job);
-    }
+    for (auto& x : d(self).queue)
+      for (auto job = x->try_pop(); job != nullptr; job = x->try_pop())
+        f(job);
   }
 };
 
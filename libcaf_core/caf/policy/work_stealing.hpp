@@ -4,20 +4,29 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <cstddef>
 #include <deque>
+#include <memory>
 #include <mutex>
 #include <random>
 #include <thread>
+#include <utility>
 
 #include "caf/actor_system_config.hpp"
 #include "caf/detail/core_export.hpp"
+#include "caf/detail/cpu_topology.hpp"
 #include "caf/detail/double_ended_queue.hpp"
+#include "caf/detail/event_count.hpp"
+#include "caf/detail/trace_buffer.hpp"
+#include "caf/detail/work_stealing_deque.hpp"
 #include "caf/policy/unprofiled.hpp"
 #include "caf/resumable.hpp"
+#include "caf/telemetry/counter.hpp"
 #include "caf/timespan.hpp"
 
 namespace caf::policy {
@@ -28,18 +37,24 @@ class CAF_CORE_EXPORT work_stealing : public unprofiled {
 public:
   ~work_stealing() override;
 
-  // A thread-safe queue implementation.
+  // A thread-safe queue implementation for jobs from other threads.
   using queue_type = detail::double_ended_queue<resumable>;
 
-  // configuration for aggressive/moderate/relaxed poll strategies.
+  // A lock-free queue implementation for jobs from the worker itself.
+  using local_queue_type = detail::work_stealing_deque<resumable>;
+
+  // configuration for aggressive/moderate poll strategies.
   struct poll_strategy {
     size_t attempts;
     size_t step_size;
     size_t steal_interval;
     timespan sleep_duration;
+    // maximum number of jobs to move from a victim in a single steal
+    size_t steal_batch_size;
   };
 
-  // The coordinator has only a counter for round-robin enqueue to its workers.
+  // The coordinator has a counter for round-robin enqueue to its workers and
+  // keeps track of workers that ran out of work.
   struct coordinator_data {
     explicit coordinator_data(scheduler::abstract_coordinator*)
       : next_worker(0) {
@@ -47,36 +62,126 @@ public:
     }
 
     std::atomic<size_t> next_worker;
+
+    // Parks idle workers until new jobs arrive.
+    detail::event_count idle_workers;
   };
 
+  // Lists the IDs of potential victims for a worker, grouped by locality.
+  using victim_list
+    = std::array<std::vector<size_t>, detail::num_cpu_localities>;
+
+  // Stores one victim list per worker.
+  using victim_table = std::vector<victim_list>;
+
   // Holds job job queue of a worker and a random number generator.
   struct worker_data {
     explicit worker_data(scheduler::abstract_coordinator* p);
     worker_data(const worker_data& other);
 
+    // Receives jobs from the worker itself. Only the owning worker pushes to
+    // and pops from the bottom, while other workers steal from the top without
+    // acquiring a lock.
+    local_queue_type local_queue;
     // This queue is exposed to other workers that may attempt to steal jobs
     // from it and the central scheduling unit can push new jobs to the queue.
     queue_type queue;
     // needed to generate pseudo random numbers
     std::default_random_engine rengine;
     std::uniform_int_distribution<size_t> uniform;
-    std::array<poll_strategy, 3> strategies;
+    std::array<poll_strategy, 2> strategies;
+    // victims grouped by locality if workers are pinned to CPUs, shared by all
+    // workers (nullptr when stealing from random victims)
+    std::shared_ptr<const victim_table> victims;
+    // counts successful steals per locality if workers are pinned to CPUs
+    std::array<telemetry::int_counter*, detail::num_cpu_localities> steals;
+    // scratch space for batch steals
+    std::vector<resumable*> stolen;
+    // the job that this worker runs next, e.g., an actor that received a
+    // message from the actor that is currently running; other workers cannot
+    // steal this job, only a stand-in for this worker takes it over
+    std::atomic<resumable*> next = nullptr;
+    // number of consecutive jobs taken from the `next` slot
+    size_t next_streak = 0;
+    // maximum value for `next_streak` before running other jobs again (0
+    // disables the `next` slot)
+    size_t max_next_streak;
   };
 
-  // Goes on a raid in quest for a shiny new job.
+  // Goes on a raid in quest for a shiny new job. Moves up to half of the
+  // victim's jobs but no more than `max_batch` jobs to our local queue.
   template <class Worker>
-  resumable* try_steal(Worker* self) {
+  resumable* try_steal(Worker* self, size_t max_batch) {
     auto p = self->parent();
+    if (auto job = take_over(self, max_batch))
+      return job;
     if (p->num_workers() < 2) {
       // you can't steal from yourself, can you?
       return nullptr;
     }
+    if (auto& victims = d(self).victims) {
+      // try a random victim per locality tier, starting with the closest one
+      auto& tiers = (*victims)[self->id()];
+      for (size_t tier = 0; tier < tiers.size(); ++tier) {
+        auto& candidates = tiers[tier];
+        if (candidates.empty())
+          continue;
+        auto victim = candidates[d(self).rengine() % candidates.size()];
+        if (auto job = steal_from(self, p->worker_by_id(victim), max_batch)) {
+          d(self).steals[tier]->inc();
+          return job;
+        }
+      }
+      return nullptr;
+    }
     // roll the dice to pick a victim other than ourselves
     auto victim = d(self).uniform(d(self).rengine);
     if (victim == self->id())
       victim = p->num_workers() - 1;
-    // steal oldest element from the victim's queue
-    return d(p->worker_by_id(victim)).queue.try_take_tail();
+    return steal_from(self, p->worker_by_id(victim), max_batch);
+  }
+
+  // Lets a stand-in for a stalled worker take over the jobs of that worker,
+  // including the job in its `next` slot. Returns `nullptr` for regular
+  // workers.
+  template <class Worker>
+  resumable* take_over(Worker* self, size_t max_batch) {
+    auto owner = self->parent()->worker_by_id(self->id());
+    if (owner == self)
+      return nullptr;
+    if (auto job = d(owner).next.exchange(nullptr, std::memory_order_acq_rel))
+      return job;
+    return steal_from(self, owner, max_batch);
+  }
+
+  // Steals the oldest elements from the victim's queues, preferring the
+  // lock-free local queue over the queue for external jobs. Returns the oldest
+  // stolen job and pushes all other stolen jobs to our local queue.
+  template <class Worker>
+  resumable* steal_from(Worker* self, Worker* victim, size_t max_batch) {
+    auto& victim_data = d(victim);
+    if (max_batch < 2) {
+      auto job = victim_data.local_queue.steal();
+      if (!job)
+        job = victim_data.queue.try_take_tail();
+      if (job)
+        self->trace(detail::trace_event_type::steal, 1);
+      return job;
+    }
+    auto& stolen = d(self).stolen;
+    stolen.clear();
+    auto out = std::back_inserter(stolen);
+    if (victim_data.local_queue.steal_half(max_batch, out) == 0) {
+      if (victim_data.queue.try_take_tail_half(max_batch, out) == 0)
+        return nullptr;
+      // the external queue yields the newest job first
+      std::reverse(stolen.begin(), stolen.end());
+    }
+    // push newest job first, since the owner pops from the bottom
+    for (auto i = stolen.size() - 1; i > 0; --i)
+      d(self).local_queue.push_bottom(stolen[i]);
+    self->trace(detail::trace_event_type::steal, stolen.size());
+    return stolen.front();
   }
 
   template <class Coordinator>
@@ -85,14 +190,72 @@ public:
     w->external_enqueue(job);
   }
 
+  // Checks all queues we have access to for a job.
+  template <class Worker>
+  resumable* try_find_job(Worker* self, size_t max_batch) {
+    if (auto job = d(self).local_queue.pop_bottom())
+      return job;
+    if (auto job = d(self).queue.try_take_head())
+      return job;
+    if (auto job = take_over(self, max_batch))
+      return job;
+    auto p = self->parent();
+    auto n = p->num_workers();
+    for (size_t i = 1; i < n; ++i)
+      if (auto job = steal_from(self, p->worker_by_id((self->id() + i) % n),
+                                max_batch))
+        return job;
+    return nullptr;
+  }
+
   template <class Worker>
   void external_enqueue(Worker* self, resumable* job) {
     d(self).queue.append(job);
+    // wake up one parked worker (if any), since the receiving worker may be
+    // busy or parked itself; a stand-in only ever runs jobs that target its
+    // stalled worker, so we need to make sure it wakes up as well
+    auto p = self->parent();
+    if (p->worker_by_id(self->id()) == self)
+      d(p).idle_workers.notify_one();
+    else
+      d(p).idle_workers.notify_all();
   }
 
   template <class Worker>
   void internal_enqueue(Worker* self, resumable* job) {
-    d(self).queue.prepend(job);
+    auto& data = d(self);
+    if (data.max_next_streak > 0) {
+      // the most recently woken up job runs next on this worker while its
+      // cache is still hot, any previous occupant of the slot moves to our
+      // queue
+      job = data.next.exchange(job, std::memory_order_acq_rel);
+      if (job == nullptr)
+        return;
+    }
+    data.local_queue.push_bottom(job);
+    // this worker runs one of its jobs right after the current one, but other
+    // jobs would have to wait for it unless a parked worker steals them
+    if (data.max_next_streak > 0 || data.local_queue.size_hint() > 1)
+      d(self->parent()).idle_workers.notify_one();
+  }
+
+  // Takes the job from the `next` slot unless it would starve other jobs.
+  template <class Worker>
+  resumable* take_next(Worker* self) {
+    auto& data = d(self);
+    if (data.next.load(std::memory_order_relaxed) == nullptr)
+      return nullptr;
+    // a stand-in may have taken the job in the meantime
+    auto job = data.next.exchange(nullptr, std::memory_order_acq_rel);
+    if (job == nullptr)
+      return nullptr;
+    if (data.next_streak < data.max_next_streak) {
+      ++data.next_streak;
+      return job;
+    }
+    // give all other jobs a chance to run before this one
+    data.queue.unsafe_append(job);
+    return nullptr;
   }
 
   template <class Worker>
@@ -104,42 +267,63 @@ public:
 
   template <class Worker>
   resumable* dequeue(Worker* self) {
+    auto* job = take_next(self);
+    if (job)
+      return job;
+    d(self).next_streak = 0;
+    // jobs from our local queue always take precedence, since only this
+    // worker can push to it
+    job = d(self).local_queue.pop_bottom();
+    if (job)
+      return job;
     // we wait for new jobs by polling our external queue: first, we
     // assume an active work load on the machine and perform aggressive
     // polling, then we relax our polling a bit and wait 50 us between
     // dequeue attempts
     auto& strategies = d(self).strategies;
-    auto* job = d(self).queue.try_take_head();
+    job = d(self).queue.try_take_head();
     if (job)
       return job;
-    for (size_t k = 0; k < 2; ++k) { // iterate over the first two strategies
-      for (size_t i = 0; i < strategies[k].attempts;
-           i += strategies[k].step_size) {
+    for (auto& strategy : strategies) {
+      for (size_t i = 0; i < strategy.attempts; i += strategy.step_size) {
         // try to steal every X poll attempts
-        if ((i % strategies[k].steal_interval) == 0) {
-          job = try_steal(self);
+        if ((i % strategy.steal_interval) == 0) {
+          job = try_steal(self, strategy.steal_batch_size);
           if (job)
             return job;
         }
         // wait for some work to appear
-        job = d(self).queue.try_take_head(strategies[k].sleep_duration);
+        job = d(self).queue.try_take_head(strategy.sleep_duration);
         if (job)
           return job;
       }
     }
-    // we assume pretty much nothing is going on so we can relax polling
-    // and falling to sleep on a condition variable whose timeout is the one
-    // of the relaxed polling strategy
-    auto& relaxed = strategies[2];
-    do {
-      job = d(self).queue.try_take_head(relaxed.sleep_duration);
-    } while (job == nullptr);
-    return job;
+    // we assume pretty much nothing is going on so we stop polling and park
+    // this worker until another thread enqueues a new job; checking all queues
+    // after announcing ourselves as waiter makes sure that we never miss a job
+    auto& idle_workers = d(self->parent()).idle_workers;
+    for (;;) {
+      auto key = idle_workers.prepare_wait();
+      job = try_find_job(self, strategies.back().steal_batch_size);
+      if (job) {
+        idle_workers.cancel_wait();
+        return job;
+      }
+      self->trace(detail::trace_event_type::park);
+      idle_workers.wait(key);
+      self->trace(detail::trace_event_type::unpark);
+    }
   }
 
   template <class Worker, class UnaryFunction>
   void foreach_resumable(Worker* self, UnaryFunction f) {
-    auto next = [&] { return d(self).queue.try_take_head(); };
+    auto next = [&] {
+      if (auto job = d(self).next.exchange(nullptr))
+        return job;
+      if (auto job = d(self).local_queue.pop_bottom())
+        return job;
+      return d(self).queue.try_take_head();
+    };
     for (auto job = next(); job != nullptr; job = next()) {
       f(job);
     }
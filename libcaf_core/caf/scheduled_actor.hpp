@@ -10,17 +10,21 @@
 #  include <exception>
 #endif // CAF_ENABLE_EXCEPTIONS
 
-#include <forward_list>
 #include <map>
 #include <type_traits>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "caf/action.hpp"
 #include "caf/actor_traits.hpp"
 #include "caf/async/fwd.hpp"
+#include "caf/const_typed_message_view.hpp"
 #include "caf/cow_string.hpp"
+#include "caf/detail/apply_args.hpp"
 #include "caf/detail/behavior_stack.hpp"
 #include "caf/detail/core_export.hpp"
+#include "caf/detail/mailbox_conflation.hpp"
 #include "caf/detail/stream_bridge.hpp"
 #include "caf/disposable.hpp"
 #include "caf/error.hpp"
@@ -152,7 +156,7 @@ public:
   using mailbox_type = intrusive::fifo_inbox<mailbox_policy>;
 
   /// The message ID of an outstanding response with its callback.
-  using pending_response = std::pair<const message_id, behavior>;
+  using pending_response = std::pair<message_id, behavior>;
 
   /// A pointer to a scheduled actor.
   using pointer = scheduled_actor*;
@@ -225,6 +229,8 @@ public:
 
   bool enqueue(mailbox_element_ptr ptr, execution_unit* eu) override;
 
+  bool enqueue_batch(mailbox_element_ptr first, execution_unit* eu) override;
+
   mailbox_element* peek_at_next_mailbox_element() override;
 
   // -- overridden functions of local_actor ------------------------------------
@@ -276,16 +282,25 @@ public:
 
   /// Sets a custom handler for unexpected messages.
   void set_default_handler(default_handler fun) {
+    skips_unexpected_messages_ = false;
     if (fun)
       default_handler_ = std::move(fun);
     else
       default_handler_ = print_and_drop;
   }
 
+  /// Leaves unexpected messages in the mailbox. The actor only retries
+  /// skipped messages once its behavior has a handler for them.
+  void set_default_handler(skip_t) {
+    skips_unexpected_messages_ = true;
+    default_handler_ = skip;
+  }
+
   /// Sets a custom handler for unexpected messages.
   template <class F>
   std::enable_if_t<std::is_invocable_r_v<skippable_result, F, message&>>
   set_default_handler(F fun) {
+    skips_unexpected_messages_ = false;
     default_handler_ = [fn{std::move(fun)}](scheduled_actor*,
                                             message& xs) mutable {
       return fn(xs);
@@ -378,6 +393,29 @@ public:
   }
 #endif // CAF_ENABLE_EXCEPTIONS
 
+  // -- mailbox management -----------------------------------------------------
+
+  /// Conflates asynchronous messages with the types `Ts...` by the key that
+  /// `f` returns for their content. A new message replaces the content of a
+  /// queued message with the same key instead of queueing up after it, i.e.,
+  /// the actor only processes the latest message per key. Requests never
+  /// replace other messages.
+  template <class... Ts, class F>
+  void conflate(F f) {
+    static_assert(sizeof...(Ts) > 0, "conflate requires at least one type");
+    static_assert(std::is_convertible_v<std::invoke_result_t<F, const Ts&...>,
+                                        std::string>,
+                  "the key function must return a string");
+    auto fn = [f{std::move(f)}](const message& msg) mutable -> std::string {
+      const_typed_message_view<Ts...> view{msg};
+      return detail::apply_args(f, std::index_sequence_for<Ts...>{}, view);
+    };
+    if (!conflation_)
+      conflation_ = std::make_unique<detail::mailbox_conflation>();
+    using key_function = detail::mailbox_conflation::key_function;
+    conflation_->add(make_type_id_list<Ts...>(), key_function{std::move(fn)});
+  }
+
   /// @cond PRIVATE
 
   // -- timeout management -----------------------------------------------------
@@ -385,6 +423,14 @@ public:
   /// Requests a new timeout for the current behavior.
   void set_receive_timeout();
 
+  /// Requests a new timeout for `mid`. Unlike the implementation in
+  /// `local_actor`, this function does not create a clock entry per request.
+  /// Instead, the actor keeps all deadlines in a heap and only schedules its
+  /// earliest deadline. Hence, the returned disposable is always empty and
+  /// timeouts for requests that received a response simply expire silently.
+  /// @pre `mid.is_request()`
+  disposable request_response_timeout(timespan d, message_id mid);
+
   // -- message processing -----------------------------------------------------
 
   /// Adds a callback for an awaited response.
@@ -422,7 +468,7 @@ public:
   }
 
   behavior& current_behavior() {
-    return !awaited_responses_.empty() ? awaited_responses_.front().second
+    return !awaited_responses_.empty() ? awaited_responses_.back().second
                                        : bhvr_stack_.back();
   }
 
@@ -448,6 +494,15 @@ public:
   /// Returns the default queue of the mailbox that stores ordinary messages.
   normal_queue& get_normal_queue();
 
+  /// Drops the oldest ordinary messages until the bounded mailbox no longer
+  /// exceeds its capacity.
+  void drop_oldest_messages();
+
+  /// Moves new messages from the inbox to the queues and conflates them with
+  /// queued messages.
+  /// @pre `conflation_ != nullptr`
+  void fetch_and_conflate();
+
   // -- caf::flow API ----------------------------------------------------------
 
   steady_time_point steady_time() override;
@@ -729,15 +784,39 @@ protected:
   /// Allows us to cancel our current in-flight timeout.
   disposable pending_timeout_;
 
-  /// Stores callbacks for awaited responses.
-  std::forward_list<pending_response> awaited_responses_;
+  /// Stores callbacks for awaited responses. The last element is the response
+  /// that the actor currently waits for.
+  std::vector<pending_response> awaited_responses_;
 
   /// Stores callbacks for multiplexed responses.
-  unordered_flat_map<message_id, behavior> multiplexed_responses_;
+  std::unordered_map<message_id, behavior> multiplexed_responses_;
+
+  /// Stores the deadlines for pending requests as min-heap.
+  std::vector<std::pair<actor_clock::time_point, message_id>> request_timeouts_;
+
+  /// Identifies the message that triggers `expire_request_timeouts`.
+  message_id request_timeout_tick_;
+
+  /// Stores when `request_timeout_tick_` arrives.
+  actor_clock::time_point next_request_timeout_;
+
+  /// Allows us to cancel `request_timeout_tick_`.
+  disposable pending_request_timeout_;
+
+  /// Stores awaited responses that timed out while the actor still waited for
+  /// another response.
+  std::vector<message_id> expired_awaited_responses_;
 
   /// Customization point for setting a default `message` callback.
   default_handler default_handler_;
 
+  /// Stores whether `default_handler_` is `skip`.
+  bool skips_unexpected_messages_ = false;
+
+  /// Tracks the latest queued message per key if the actor conflates
+  /// messages.
+  std::unique_ptr<detail::mailbox_conflation> conflation_;
+
   /// Customization point for setting a default `error` callback.
   error_handler error_handler_;
 
@@ -753,17 +832,68 @@ protected:
   /// Pointer to a private thread object associated with a detached actor.
   detail::private_thread* private_thread_;
 
+  /// Points to the named scheduler pool of this actor or is `nullptr` if this
+  /// actor runs in the default scheduler.
+  scheduler::abstract_coordinator* pool_;
+
+  /// Number of messages this actor consumes per DRR round from its normal
+  /// queue. Grows while the actor has a backlog and resets once the actor
+  /// drained its mailbox.
+  size_t drr_quantum_;
+
 #ifdef CAF_ENABLE_EXCEPTIONS
   /// Customization point for setting a default exception callback.
   exception_handler exception_handler_;
 #endif // CAF_ENABLE_EXCEPTIONS
 
 private:
+  // -- member types -----------------------------------------------------------
+
+  /// Decides which skipped messages the actor retries after consuming a
+  /// message. Unless the actor uses `skip` as default handler, it retries all
+  /// skipped messages. Otherwise, it only retries messages with types that its
+  /// current behavior accepts, since `skip` would leave all other messages in
+  /// the mailbox again.
+  class cache_filter {
+  public:
+    explicit cache_filter(scheduled_actor* self) noexcept : self_(self) {
+      // nop
+    }
+
+    bool retry_all() noexcept;
+
+    bool retry(type_id_list types) const noexcept;
+
+    /// Forces the next flush to retry all messages, e.g., after skipping
+    /// messages while awaiting a response.
+    void mark_dirty() noexcept {
+      dirty_ = true;
+    }
+
+  private:
+    scheduled_actor* self_;
+    bool dirty_ = false;
+  };
+
+  // -- scheduling -------------------------------------------------------------
+
+  /// Schedules this actor for execution, either on `ctx` if it belongs to the
+  /// pool of this actor or else via the scheduler of this actor.
+  void schedule(execution_unit* ctx);
+
   // -- utilities for instrumenting actors -------------------------------------
 
   template <class F>
   intrusive::task_result run_with_metrics(mailbox_element& x, F body) {
-    if (metrics_.mailbox_time) {
+    if (!metrics_.mailbox_time) {
+      return body();
+    } else if (!x.has_enqueue_time()) {
+      // Only messages with a timestamp contribute to the histograms.
+      auto res = body();
+      if (res != intrusive::task_result::skip)
+        metrics_.mailbox_size->dec();
+      return res;
+    } else {
       auto t0 = std::chrono::steady_clock::now();
       auto mbox_time = x.seconds_until(t0);
       auto res = body();
@@ -773,8 +903,6 @@ private:
         metrics_.mailbox_size->dec();
       }
       return res;
-    } else {
-      return body();
     }
   }
 
@@ -787,6 +915,20 @@ private:
   disposable run_delayed(timespan delay, action what);
   disposable run_delayed_weak(timespan delay, action what);
 
+  /// Schedules `request_timeout_tick_` for `when`.
+  void schedule_request_timeout_tick(actor_clock::time_point when);
+
+  /// Calls the response handlers of all pending requests with expired
+  /// deadlines with a `request_timeout` error.
+  void expire_request_timeouts();
+
+  /// Calls the response handlers of expired awaited responses as long as the
+  /// actor waits for one of them.
+  void expire_awaited_responses();
+
+  /// Drops all response handlers.
+  void clear_response_handlers();
+
   // -- caf::flow bindings -----------------------------------------------------
 
   template <class T, class Policy>
@@ -851,6 +993,14 @@ private:
   /// This is to make sure that actor does not terminate because it thinks it's
   /// done before processing the delayed action.
   behavior delay_bhvr_;
+
+  /// Selects which skipped messages to retry from the cache of the normal
+  /// queue.
+  cache_filter normal_cache_filter_{this};
+
+  /// Selects which skipped messages to retry from the cache of the urgent
+  /// queue.
+  cache_filter urgent_cache_filter_{this};
 };
 
 } // namespace caf
@@ -7,6 +7,7 @@
 #include <atomic>
 #include <chrono>
 #include <cstddef>
+#include <string>
 
 #include "caf/actor.hpp"
 #include "caf/actor_addr.hpp"
@@ -14,8 +15,10 @@
 #include "caf/actor_clock.hpp"
 #include "caf/actor_system.hpp"
 #include "caf/detail/core_export.hpp"
+#include "caf/detail/cpu_topology.hpp"
 #include "caf/fwd.hpp"
 #include "caf/message.hpp"
+#include "caf/timespan.hpp"
 
 namespace caf::scheduler {
 
@@ -27,7 +30,8 @@ class CAF_CORE_EXPORT abstract_coordinator : public actor_system::module {
 public:
   enum utility_actor_id : size_t { printer_id, max_id };
 
-  explicit abstract_coordinator(actor_system& sys);
+  explicit abstract_coordinator(actor_system& sys,
+                                std::string pool_name = "default");
 
   /// Returns a handle to the central printing actor.
   actor printer() const {
@@ -52,10 +56,62 @@ public:
     return max_throughput_;
   }
 
+  /// Returns how long an actor may spend in its message handlers per resume
+  /// or 0 if only `max_throughput` limits the work per resume.
+  timespan max_run_time() const noexcept {
+    return max_run_time_;
+  }
+
+  /// Returns after how much time in a single resume the watchdog reports a
+  /// worker as stalled or 0 if the watchdog is disabled.
+  timespan stall_threshold() const noexcept {
+    return stall_threshold_;
+  }
+
+  /// Returns whether the watchdog starts a stand-in for stalled workers.
+  bool replace_stalled_workers() const noexcept {
+    return replace_stalled_workers_;
+  }
+
+  /// Returns the initial number of messages an actor consumes per DRR round
+  /// from each of its mailbox queues.
+  size_t drr_quantum() const noexcept {
+    return drr_quantum_;
+  }
+
+  /// Returns the maximum value for the quantum of a backlogged actor.
+  size_t max_drr_quantum() const noexcept {
+    return max_drr_quantum_;
+  }
+
   size_t num_workers() const {
     return num_workers_;
   }
 
+  /// Returns the name of the scheduler pool for labeling metrics, i.e.,
+  /// "default" for the scheduler of the actor system or the name of the pool
+  /// in `caf.scheduler.pools`.
+  const std::string& pool_name() const noexcept {
+    return pool_name_;
+  }
+
+  /// Returns whether this coordinator is the default scheduler of the actor
+  /// system rather than a named scheduler pool.
+  bool is_default_pool() const noexcept {
+    return pool_name_ == "default";
+  }
+
+  /// Returns the number of workers as configured by the user. Named pools read
+  /// `max-threads` from their entry in `caf.scheduler.pools` and fall back to
+  /// `caf.scheduler.max-threads`.
+  size_t configured_num_workers() const;
+
+  /// Returns the CPU topology for pinning workers to CPUs. The topology is
+  /// empty unless `caf.scheduler.pin-workers` is enabled.
+  const detail::cpu_topology& topology() const noexcept {
+    return topology_;
+  }
+
   /// Returns `true` if this scheduler detaches its utility actors.
   virtual bool detaches_utility_actors() const;
 
@@ -82,9 +138,39 @@ protected:
   /// Number of messages each actor is allowed to consume per resume.
   size_t max_throughput_;
 
+  /// Time each actor is allowed to spend in message handlers per resume.
+  timespan max_run_time_;
+
+  /// Initial DRR quantum for each actor.
+  size_t drr_quantum_;
+
+  /// Upper bound for the DRR quantum of an actor.
+  size_t max_drr_quantum_;
+
+  /// Minimum duration of a single resume for reporting a stalled worker.
+  timespan stall_threshold_;
+
+  /// Configures whether the watchdog replaces stalled workers.
+  bool replace_stalled_workers_;
+
+  /// Output file for scheduler traces or an empty string if tracing is off.
+  std::string trace_file_;
+
+  /// Number of trace events each worker can buffer.
+  size_t trace_buffer_size_;
+
+  /// Time between two runs of the background thread that writes the trace.
+  timespan trace_flush_interval_;
+
   /// Configured number of workers.
   size_t num_workers_;
 
+  /// CPU topology of the host if pinning workers is enabled.
+  detail::cpu_topology topology_;
+
+  /// Name of the pool for metrics and configuration lookups.
+  std::string pool_name_;
+
   /// Background workers, e.g., printer.
   std::array<actor, max_id> utility_actors_;
 
@@ -9,10 +9,15 @@
 #include <condition_variable>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 #include "caf/detail/set_thread_name.hpp"
 #include "caf/detail/thread_safe_actor_clock.hpp"
+#include "caf/detail/trace_writer.hpp"
+#include "caf/make_counted.hpp"
+#include "caf/ref_counted.hpp"
 #include "caf/scheduler/abstract_coordinator.hpp"
 #include "caf/scheduler/worker.hpp"
 
@@ -30,6 +35,13 @@ public:
     // nop
   }
 
+  /// Creates a named scheduler pool that shares the clock and the utility
+  /// actors of the default scheduler.
+  coordinator(actor_system& sys, std::string pool_name)
+    : super(sys, std::move(pool_name)), data_(this) {
+    // nop
+  }
+
   using worker_type = worker<Policy>;
 
   worker_type* worker_by_id(size_t x) {
@@ -55,15 +67,47 @@ protected:
     for (size_t i = 0; i < num; ++i)
       workers_.emplace_back(
         std::make_unique<worker_type>(i, this, init, max_throughput_));
+    // Give each worker a trace buffer if tracing is enabled.
+    if (!trace_file_.empty()) {
+      auto tracer = std::make_unique<detail::trace_writer>(
+        trace_file_, "caf.scheduler." + pool_name(), trace_buffer_size_,
+        trace_flush_interval_);
+      if (tracer->start(system())) {
+        for (auto& w : workers_)
+          w->trace_buffer(tracer->make_buffer(
+            w->id(), "caf.worker." + std::to_string(w->id())));
+        tracer_ = std::move(tracer);
+      }
+    }
     // Start all workers.
     for (auto& w : workers_)
       w->start();
+    // Start the watchdog if needed.
+    if (stall_threshold_.count() > 0) {
+      stalls_ = system().metrics().counter_instance(
+        "caf.scheduler", "stalls", {{"pool", pool_name()}},
+        "Number of jobs that ran longer than the stall threshold.", "1", true);
+      watchdog_ = system().launch_thread("caf.watchdog",
+                                         thread_owner::scheduler,
+                                         [this] { watch_workers(); });
+    }
     // Run remaining startup code.
-    clock_.start_dispatch_loop(system());
-    super::start();
+    if (is_default_pool()) {
+      clock_.start_dispatch_loop(system());
+      super::start();
+    }
   }
 
   void stop() override {
+    // Stop the watchdog and all stand-in workers.
+    if (watchdog_.joinable()) {
+      {
+        std::unique_lock guard{watchdog_mtx_};
+        watchdog_stop_ = true;
+        watchdog_cv_.notify_all();
+      }
+      watchdog_.join();
+    }
     // Shutdown workers.
     class shutdown_helper : public resumable, public ref_counted {
     public:
@@ -108,7 +152,8 @@ protected:
       sh.last_worker = nullptr;
     }
     // Shutdown utility actors.
-    stop_actors();
+    if (is_default_pool())
+      stop_actors();
     // Wait until all workers are done.
     for (auto& w : workers_) {
       w->get_thread().join();
@@ -118,8 +163,12 @@ protected:
     for (auto& w : workers_)
       policy_.foreach_resumable(w.get(), f);
     policy_.foreach_central_resumable(this, f);
+    // Write the remaining trace events.
+    if (tracer_)
+      tracer_->stop();
     // Stop timer thread.
-    clock_.stop_dispatch_loop();
+    if (is_default_pool())
+      clock_.stop_dispatch_loop();
   }
 
   void enqueue(resumable* ptr) override {
@@ -131,6 +180,124 @@ protected:
   }
 
 private:
+  // -- stall detection --------------------------------------------------------
+
+  /// Shuts down the stand-in for a stalled worker. With work sharing, other
+  /// workers may dequeue this job as well. They pass it on to the stand-in.
+  class retire_job : public resumable, public ref_counted {
+  public:
+    explicit retire_job(worker_type* target) : target_(target) {
+      // nop
+    }
+
+    resumable::resume_result resume(execution_unit* ctx, size_t) override {
+      if (ctx == target_)
+        return resumable::shutdown_execution_unit;
+      // The worker releases one reference after `awaiting_message`.
+      intrusive_ptr_add_ref(this);
+      target_->external_enqueue(this);
+      return resumable::awaiting_message;
+    }
+
+    void intrusive_ptr_add_ref_impl() override {
+      intrusive_ptr_add_ref(this);
+    }
+
+    void intrusive_ptr_release_impl() override {
+      intrusive_ptr_release(this);
+    }
+
+  private:
+    worker_type* target_;
+  };
+
+  /// Runs a worker in place of a stalled worker until the stalled worker
+  /// finishes its current job.
+  struct stand_in {
+    std::unique_ptr<worker_type> worker;
+    intrusive_ptr<retire_job> retire;
+  };
+
+  /// Periodically checks whether a worker spends more time than the threshold
+  /// in a single resume.
+  void watch_workers() {
+    using std::chrono::duration_cast;
+    using std::chrono::milliseconds;
+    using std::chrono::nanoseconds;
+    auto threshold = duration_cast<nanoseconds>(stall_threshold_).count();
+    auto interval = std::max(stall_threshold_ / 2, timespan{1'000'000});
+    auto num = workers_.size();
+    // Stores the sequence number of the last reported resume per worker.
+    std::vector<uint64_t> reported(num, 0);
+    std::vector<stand_in> stand_ins(num);
+    std::vector<stand_in> retired;
+    auto retire = [&retired](stand_in& x) {
+      x.worker->external_enqueue(x.retire.get());
+      retired.emplace_back(std::move(x));
+      x = stand_in{};
+    };
+    std::unique_lock guard{watchdog_mtx_};
+    while (!watchdog_cv_.wait_for(guard, interval,
+                                  [this] { return watchdog_stop_; })) {
+      auto now = detail::worker_activity::now();
+      for (size_t id = 0; id < num; ++id) {
+        auto snapshot = workers_[id]->activity().read();
+        if (snapshot.since == 0 || now - snapshot.since < threshold) {
+          // The worker is healthy (again).
+          if (stand_ins[id].worker)
+            retire(stand_ins[id]);
+          continue;
+        }
+        if (snapshot.seq == reported[id])
+          continue;
+        reported[id] = snapshot.seq;
+        stalls_->inc();
+        auto elapsed = duration_cast<milliseconds>(
+          nanoseconds{now - snapshot.since});
+        CAF_LOG_WARNING("worker" << id << "of scheduler pool" << pool_name()
+                                 << "stalled for" << elapsed.count()
+                                 << "ms while running"
+                                 << (snapshot.aid != 0 ? "actor" : "a job")
+                                 << "with ID" << snapshot.aid);
+        if (replace_stalled_workers_ && !stand_ins[id].worker) {
+          typename worker_type::policy_data init{this};
+          auto& x = stand_ins[id];
+          x.worker = std::make_unique<worker_type>(id, this, init,
+                                                   max_throughput_);
+          x.retire = make_counted<retire_job>(x.worker.get());
+          x.worker->start();
+        }
+      }
+    }
+    guard.unlock();
+    for (auto& x : stand_ins)
+      if (x.worker)
+        retire(x);
+    auto f = &abstract_coordinator::cleanup_and_release;
+    for (auto& x : retired) {
+      x.worker->get_thread().join();
+      policy_.foreach_resumable(x.worker.get(), f);
+    }
+  }
+
+  /// Writes the trace events of all workers if tracing is enabled.
+  std::unique_ptr<detail::trace_writer> tracer_;
+
+  /// Counts stalled workers.
+  telemetry::int_counter* stalls_ = nullptr;
+
+  /// Detects stalled workers if `stall_threshold_` is non-zero.
+  std::thread watchdog_;
+
+  /// Protects `watchdog_stop_`.
+  std::mutex watchdog_mtx_;
+
+  /// Signals the watchdog to stop.
+  std::condition_variable watchdog_cv_;
+
+  /// Tells the watchdog to stop.
+  bool watchdog_stop_ = false;
+
   /// System-wide clock.
   detail::thread_safe_actor_clock clock_;
 
@@ -6,8 +6,11 @@
 
 #include <cstddef>
 
+#include "caf/detail/cpu_topology.hpp"
 #include "caf/detail/double_ended_queue.hpp"
 #include "caf/detail/set_thread_name.hpp"
+#include "caf/detail/trace_buffer.hpp"
+#include "caf/detail/worker_activity.hpp"
 #include "caf/execution_unit.hpp"
 #include "caf/logger.hpp"
 #include "caf/resumable.hpp"
@@ -32,8 +35,10 @@ public:
       max_throughput_(throughput),
       id_(worker_id),
       parent_(worker_parent),
-      data_(init) {
-    // nop
+      data_(init),
+      watched_(worker_parent->stall_threshold().count() > 0) {
+    if (!worker_parent->is_default_pool())
+      pool_ = worker_parent;
   }
 
   void start() {
@@ -86,16 +91,39 @@ public:
     return max_throughput_;
   }
 
+  /// Returns the job that this worker currently runs for the stall watchdog.
+  const detail::worker_activity& activity() const noexcept {
+    return activity_;
+  }
+
+  /// Appends an event to the trace buffer of this worker if tracing is on.
+  void trace(detail::trace_event_type type, uint64_t value = 0) noexcept {
+    if (trace_buffer_ != nullptr)
+      trace_buffer_->push(type, value);
+  }
+
 private:
   void run() {
     CAF_SET_LOGGER_SYS(&system());
+    if (auto& topology = parent_->topology(); !topology.empty()) {
+      auto cpu = topology.cpu_for_worker(id_).cpu;
+      if (!detail::set_thread_affinity(cpu))
+        CAF_LOG_WARNING("failed to pin worker" << id_ << "to CPU" << cpu);
+    }
     // scheduling loop
     for (;;) {
       auto job = policy_.dequeue(this);
       CAF_ASSERT(job != nullptr);
       CAF_ASSERT(job->subtype() != resumable::io_actor);
       policy_.before_resume(this, job);
+      if (watched_)
+        activity_.begin(job);
+      if (trace_buffer_ != nullptr)
+        trace_buffer_->push_resume_begin(job);
       auto res = job->resume(this, max_throughput_);
+      trace(detail::trace_event_type::resume_end);
+      if (watched_)
+        activity_.end();
       policy_.after_resume(this, job);
       switch (res) {
         case resumable::resume_later: {
@@ -133,6 +161,10 @@ private:
   policy_data data_;
   // instance of our policy object
   Policy policy_;
+  // enables publishing the current job to `activity_`
+  bool watched_;
+  // the current job for the stall watchdog
+  detail::worker_activity activity_;
 };
 
 } // namespace caf::scheduler
@@ -163,6 +163,9 @@ enum class sec : uint8_t {
   protocol_error,
   /// Encountered faulty logic in the program.
   logic_error,
+  /// Signals that the receiver dropped a message, because its mailbox reached
+  /// its capacity.
+  mailbox_full,
 };
 // --(rst-sec-end)--
 
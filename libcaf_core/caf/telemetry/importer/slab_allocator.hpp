@@ -0,0 +1,38 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/detail/core_export.hpp"
+#include "caf/fwd.hpp"
+
+namespace caf::telemetry::importer {
+
+/// Imports the counters of the @ref detail::slab_allocator that CAF uses for
+/// mailbox elements and message data. The importer adds the metrics
+/// `caf.slab-allocator.hits`, `caf.slab-allocator.refills`,
+/// `caf.slab-allocator.misses`, `caf.slab-allocator.heap-allocations`,
+/// `caf.slab-allocator.remote-frees` and `caf.slab-allocator.reserved-bytes`.
+/// The ratio of hits to all allocations is the hit rate of the thread-local
+/// pools.
+///
+/// @note CAF adds this importer automatically when configuring export to
+///       Prometheus via HTTP.
+class CAF_CORE_EXPORT slab_allocator {
+public:
+  explicit slab_allocator(metric_registry& reg);
+
+  /// Updates the allocator metrics.
+  void update();
+
+private:
+  telemetry::int_counter* hits_ = nullptr;
+  telemetry::int_counter* refills_ = nullptr;
+  telemetry::int_counter* misses_ = nullptr;
+  telemetry::int_counter* heap_allocations_ = nullptr;
+  telemetry::int_counter* remote_frees_ = nullptr;
+  telemetry::int_gauge* reserved_bytes_ = nullptr;
+};
+
+} // namespace caf::telemetry::importer
@@ -8,6 +8,7 @@
 #include <cstdint>
 #include <cstring>
 #include <string>
+#include <string_view>
 
 #include "caf/detail/comparable.hpp"
 #include "caf/detail/core_export.hpp"
@@ -156,3 +157,17 @@ constexpr type_id_list to_type_id_list() {
 }
 
 } // namespace caf::detail
+
+namespace std {
+
+template <>
+struct hash<caf::type_id_list> {
+  size_t operator()(caf::type_id_list xs) const noexcept {
+    // Hashes the size prefix and all type IDs.
+    auto bytes = reinterpret_cast<const char*>(xs.data());
+    auto size = (xs.size() + 1) * sizeof(caf::type_id_t);
+    return hash<string_view>{}(string_view{bytes, size});
+  }
+};
+
+} // namespace std
@@ -45,6 +45,19 @@ bool abstract_actor::enqueue(strong_actor_ptr sender, message_id mid,
   return enqueue(make_mailbox_element(sender, mid, {}, std::move(msg)), host);
 }
 
+bool abstract_actor::enqueue_batch(mailbox_element_ptr first,
+                                   execution_unit* host) {
+  auto result = true;
+  while (first != nullptr) {
+    mailbox_element_ptr next{static_cast<mailbox_element*>(first->next)};
+    first->next = nullptr;
+    if (!enqueue(std::move(first), host))
+      result = false;
+    first = std::move(next);
+  }
+  return result;
+}
+
 abstract_actor::abstract_actor(actor_config& cfg)
   : abstract_channel(cfg.flags) {
   // nop
@@ -75,6 +88,14 @@ mailbox_element* abstract_actor::peek_at_next_mailbox_element() {
   return nullptr;
 }
 
+void abstract_actor::track_queued_messages() {
+  // nop
+}
+
+size_t abstract_actor::queued_messages() const noexcept {
+  return 0;
+}
+
 void abstract_actor::register_at_system() {
   if (getf(is_registered_flag))
     return;
@@ -4,6 +4,7 @@
 
 #include "caf/actor_pool.hpp"
 
+#include <algorithm>
 #include <atomic>
 #include <random>
 
@@ -14,6 +15,49 @@
 
 namespace caf {
 
+namespace {
+
+// Draws a random index in the range [0, n) from a per-thread engine, since
+// senders may dispatch concurrently.
+size_t random_index(size_t n) {
+  thread_local std::minstd_rand engine{std::random_device{}()};
+  return std::uniform_int_distribution<size_t>{0, n - 1}(engine);
+}
+
+// Scrambles the bits of `x` (finalizer of the SplitMix64 generator).
+uint64_t mix(uint64_t x) noexcept {
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+  return x ^ (x >> 31);
+}
+
+bool is_control_message(const message& content) {
+  return (!content.empty() && content.match_element<sys_atom>(0))
+         || content.match_elements<exit_msg>()
+         || content.match_elements<down_msg>();
+}
+
+// Announces a sender that accesses a snapshot of the workers.
+class reader_guard {
+public:
+  explicit reader_guard(std::atomic<size_t>& readers) : readers_(readers) {
+    readers_.fetch_add(1);
+  }
+
+  reader_guard(const reader_guard&) = delete;
+
+  reader_guard& operator=(const reader_guard&) = delete;
+
+  ~reader_guard() {
+    readers_.fetch_sub(1, std::memory_order_release);
+  }
+
+private:
+  std::atomic<size_t>& readers_;
+};
+
+} // namespace
+
 actor_pool::policy actor_pool::round_robin() {
   struct impl {
     impl() : pos_(0) {
@@ -22,12 +66,11 @@ actor_pool::policy actor_pool::round_robin() {
     impl(const impl&) : pos_(0) {
       // nop
     }
-    void operator()(actor_system&, guard_type& guard, const actor_vec& vec,
+    void operator()(actor_system&, const actor_vec& vec,
                     mailbox_element_ptr& ptr, execution_unit* host) {
       CAF_ASSERT(!vec.empty());
-      actor selected = vec[pos_++ % vec.size()];
-      guard.unlock();
-      selected->enqueue(std::move(ptr), host);
+      auto pos = pos_.fetch_add(1, std::memory_order_relaxed);
+      vec[pos % vec.size()]->enqueue(std::move(ptr), host);
     }
     std::atomic<size_t> pos_;
   };
@@ -36,8 +79,7 @@ actor_pool::policy actor_pool::round_robin() {
 
 namespace {
 
-void broadcast_dispatch(actor_system&, actor_pool::guard_type&,
-                        const actor_pool::actor_vec& vec,
+void broadcast_dispatch(actor_system&, const actor_pool::actor_vec& vec,
                         mailbox_element_ptr& ptr, execution_unit* host) {
   CAF_ASSERT(!vec.empty());
   auto msg = ptr->payload;
@@ -45,6 +87,31 @@ void broadcast_dispatch(actor_system&, actor_pool::guard_type&,
     worker->enqueue(ptr->sender, ptr->mid, msg, host);
 }
 
+void random_dispatch(actor_system&, const actor_pool::actor_vec& vec,
+                     mailbox_element_ptr& ptr, execution_unit* host) {
+  CAF_ASSERT(!vec.empty());
+  vec[random_index(vec.size())]->enqueue(std::move(ptr), host);
+}
+
+void power_of_two_dispatch(actor_system&, const actor_pool::actor_vec& vec,
+                           mailbox_element_ptr& ptr, execution_unit* host) {
+  CAF_ASSERT(!vec.empty());
+  auto n = vec.size();
+  if (n == 1) {
+    vec[0]->enqueue(std::move(ptr), host);
+    return;
+  }
+  // Draw two distinct workers.
+  auto i = random_index(n);
+  auto j = random_index(n - 1);
+  if (j >= i)
+    ++j;
+  auto& selected = vec[i]->queued_messages() <= vec[j]->queued_messages()
+                     ? vec[i]
+                     : vec[j];
+  selected->enqueue(std::move(ptr), host);
+}
+
 } // namespace
 
 actor_pool::policy actor_pool::broadcast() {
@@ -52,28 +119,68 @@ actor_pool::policy actor_pool::broadcast() {
 }
 
 actor_pool::policy actor_pool::random() {
+  return random_dispatch;
+}
+
+actor_pool::policy actor_pool::least_loaded() {
   struct impl {
-    impl() : rd_() {
+    impl() : pos_(0) {
       // nop
     }
-    impl(const impl&) : rd_() {
+    impl(const impl&) : pos_(0) {
       // nop
     }
-    void operator()(actor_system&, guard_type& guard, const actor_vec& vec,
+    void operator()(actor_system&, const actor_vec& vec,
                     mailbox_element_ptr& ptr, execution_unit* host) {
-      auto selected
-        = vec[dis_(rd_, decltype(dis_)::param_type(0, vec.size() - 1))];
-      guard.unlock();
-      selected->enqueue(std::move(ptr), host);
+      CAF_ASSERT(!vec.empty());
+      // Start at a rotating position to spread messages among idle workers.
+      auto n = vec.size();
+      auto first = pos_.fetch_add(1, std::memory_order_relaxed) % n;
+      auto best = first;
+      auto best_load = vec[first]->queued_messages();
+      for (size_t i = 1; i < n && best_load > 0; ++i) {
+        auto pos = (first + i) % n;
+        if (auto load = vec[pos]->queued_messages(); load < best_load) {
+          best = pos;
+          best_load = load;
+        }
+      }
+      vec[best]->enqueue(std::move(ptr), host);
     }
-    std::random_device rd_;
-    std::uniform_int_distribution<size_t> dis_;
+    std::atomic<size_t> pos_;
   };
   return impl{};
 }
 
+actor_pool::policy actor_pool::power_of_two() {
+  return power_of_two_dispatch;
+}
+
+actor_pool::policy actor_pool::consistent_hash(key_function key) {
+  // Uses rendezvous hashing: each message goes to the worker with the highest
+  // score for its key. Unlike a hash ring, this requires no state that we
+  // would need to rebuild whenever the set of workers changes.
+  return [key{std::move(key)}](actor_system&, const actor_vec& vec,
+                               mailbox_element_ptr& ptr, execution_unit* host) {
+    CAF_ASSERT(!vec.empty());
+    auto hash = mix(key(ptr->payload));
+    auto score = [hash](const actor& worker) {
+      return mix(hash ^ mix(worker->id()));
+    };
+    auto best = vec.begin();
+    auto best_score = score(*best);
+    for (auto i = best + 1; i != vec.end(); ++i) {
+      if (auto x = score(*i); x > best_score) {
+        best = i;
+        best_score = x;
+      }
+    }
+    (*best)->enqueue(std::move(ptr), host);
+  };
+}
+
 actor_pool::~actor_pool() {
-  // nop
+  delete workers_.load();
 }
 
 actor actor_pool::make(execution_unit* eu, policy pol) {
@@ -91,26 +198,43 @@ actor actor_pool::make(execution_unit* eu, size_t num_workers,
                        const factory& fac, policy pol) {
   auto res = make(eu, std::move(pol));
   auto ptr = static_cast<actor_pool*>(actor_cast<abstract_actor*>(res));
-  auto res_addr = ptr->address();
+  actor_vec workers;
+  workers.reserve(num_workers);
   for (size_t i = 0; i < num_workers; ++i) {
     auto worker = fac();
-    worker->attach(
-      default_attachable::make_monitor(worker.address(), res_addr));
-    ptr->workers_.push_back(std::move(worker));
+    ptr->init_worker(worker);
+    workers.push_back(std::move(worker));
   }
+  guard_type guard{ptr->workers_mtx_};
+  ptr->set_workers(std::move(workers));
   return res;
 }
 
 bool actor_pool::enqueue(mailbox_element_ptr what, execution_unit* eu) {
-  guard_type guard{workers_mtx_};
-  if (filter(guard, what->sender, what->mid, what->payload, eu))
+  if (is_control_message(what->payload)) {
+    guard_type guard{workers_mtx_};
+    if (filter(guard, what->sender, what->mid, what->payload, eu))
+      return false;
+  }
+  reader_guard reading{readers_};
+  auto workers = workers_.load();
+  if (workers->empty()) {
+    if (what->mid.is_request() && what->sender != nullptr) {
+      // Tell client we have ignored this request message by sending and empty
+      // message back.
+      what->sender->enqueue(nullptr, what->mid.response_id(), message{}, eu);
+    }
     return false;
-  policy_(home_system(), guard, workers_, what, eu);
+  }
+  policy_(home_system(), *workers, what, eu);
   return true;
 }
 
 actor_pool::actor_pool(actor_config& cfg)
-  : monitorable_actor(cfg), planned_reason_(exit_reason::normal) {
+  : monitorable_actor(cfg),
+    workers_(new actor_vec),
+    readers_(0),
+    planned_reason_(exit_reason::normal) {
   register_at_system();
 }
 
@@ -133,13 +257,12 @@ bool actor_pool::filter(guard_type& guard, const strong_actor_ptr& sender,
                         message_id mid, message& content, execution_unit* eu) {
   CAF_LOG_TRACE(CAF_ARG(mid) << CAF_ARG(content));
   if (auto view = make_const_typed_message_view<exit_msg>(content)) {
-    // acquire second mutex as well
-    std::vector<actor> workers;
     auto reason = get<0>(view).reason;
     if (cleanup(std::move(reason), eu)) {
       // send exit messages *always* to all workers and clear vector afterwards
-      // but first swap workers_ out of the critical section
-      workers_.swap(workers);
+      // but first move the workers out of the critical section
+      auto workers = *workers_.load();
+      set_workers(actor_vec{});
       guard.unlock();
       for (auto& w : workers)
         anon_send(w, content);
@@ -150,12 +273,15 @@ bool actor_pool::filter(guard_type& guard, const strong_actor_ptr& sender,
   if (auto view = make_const_typed_message_view<down_msg>(content)) {
     // remove failed worker from pool
     const auto& dm = get<0>(view);
-    auto last = workers_.end();
-    auto i = std::find(workers_.begin(), workers_.end(), dm.source);
+    auto workers = *workers_.load();
+    auto last = workers.end();
+    auto i = std::find(workers.begin(), workers.end(), dm.source);
     CAF_LOG_DEBUG_IF(i == last, "received down message for an unknown worker");
-    if (i != last)
-      workers_.erase(i);
-    if (workers_.empty()) {
+    if (i != last) {
+      workers.erase(i);
+      set_workers(workers);
+    }
+    if (workers.empty()) {
       planned_reason_ = exit_reason::out_of_workers;
       guard.unlock();
       quit(eu);
@@ -165,52 +291,61 @@ bool actor_pool::filter(guard_type& guard, const strong_actor_ptr& sender,
   if (auto view
       = make_const_typed_message_view<sys_atom, put_atom, actor>(content)) {
     const auto& worker = get<2>(view);
-    worker->attach(
-      default_attachable::make_monitor(worker.address(), address()));
-    workers_.push_back(worker);
+    init_worker(worker);
+    auto workers = *workers_.load();
+    workers.push_back(worker);
+    set_workers(std::move(workers));
     return true;
   }
   if (auto view
       = make_const_typed_message_view<sys_atom, delete_atom, actor>(content)) {
     auto& what = get<2>(view);
-    auto last = workers_.end();
-    auto i = std::find(workers_.begin(), last, what);
+    auto workers = *workers_.load();
+    auto last = workers.end();
+    auto i = std::find(workers.begin(), last, what);
     if (i != last) {
       default_attachable::observe_token tk{address(),
                                            default_attachable::monitor};
       what->detach(tk);
-      workers_.erase(i);
+      workers.erase(i);
+      set_workers(std::move(workers));
     }
     return true;
   }
   if (content.match_elements<sys_atom, delete_atom>()) {
-    for (auto& worker : workers_) {
+    for (auto& worker : *workers_.load()) {
       default_attachable::observe_token tk{address(),
                                            default_attachable::monitor};
       worker->detach(tk);
     }
-    workers_.clear();
+    set_workers(actor_vec{});
     return true;
   }
   if (content.match_elements<sys_atom, get_atom>()) {
-    auto cpy = workers_;
+    auto cpy = *workers_.load();
     guard.unlock();
     sender->enqueue(nullptr, mid.response_id(), make_message(std::move(cpy)),
                     eu);
     return true;
   }
-  if (workers_.empty()) {
-    guard.unlock();
-    if (mid.is_request() && sender != nullptr) {
-      // Tell client we have ignored this request message by sending and empty
-      // message back.
-      sender->enqueue(nullptr, mid.response_id(), message{}, eu);
-    }
-    return true;
-  }
   return false;
 }
 
+void actor_pool::init_worker(const actor& worker) {
+  worker->attach(
+    default_attachable::make_monitor(worker.address(), address()));
+  worker->track_queued_messages();
+}
+
+void actor_pool::set_workers(actor_vec workers) {
+  auto fresh = std::make_unique<const actor_vec>(std::move(workers));
+  retired_.emplace_back(workers_.exchange(fresh.release()));
+  // Senders that load workers_ from now on see the new snapshot. Hence, we may
+  // release all previous snapshots if no sender accesses one at the moment.
+  if (readers_.load() == 0)
+    retired_.clear();
+}
+
 void actor_pool::quit(execution_unit* host) {
   // we can safely run our cleanup code here without holding
   // workers_mtx_ because abstract_actor has its own lock
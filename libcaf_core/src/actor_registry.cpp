@@ -37,9 +37,10 @@ actor_registry::actor_registry(actor_system& sys) : system_(sys) {
 }
 
 strong_actor_ptr actor_registry::get_impl(actor_id key) const {
-  shared_guard guard(instances_mtx_);
-  auto i = entries_.find(key);
-  if (i != entries_.end())
+  auto& x = shard_of(key);
+  std::unique_lock guard{x.mtx};
+  auto i = x.actors.find(key);
+  if (i != x.actors.end())
     return i->second;
   CAF_LOG_DEBUG("key invalid, assume actor no longer exists:" << CAF_ARG(key));
   return nullptr;
@@ -50,8 +51,9 @@ void actor_registry::put_impl(actor_id key, strong_actor_ptr val) {
   if (!val)
     return;
   { // lifetime scope of guard
-    exclusive_guard guard(instances_mtx_);
-    if (!entries_.emplace(key, val).second)
+    auto& x = shard_of(key);
+    std::unique_lock guard{x.mtx};
+    if (!x.actors.emplace(key, val).second)
       return;
   }
   // attach functor without lock
@@ -67,11 +69,12 @@ void actor_registry::erase(actor_id key) {
   // that in turn calls this function and we can end up in a deadlock.
   strong_actor_ptr ref;
   { // Lifetime scope of guard.
-    exclusive_guard guard{instances_mtx_};
-    auto i = entries_.find(key);
-    if (i != entries_.end()) {
+    auto& x = shard_of(key);
+    std::unique_lock guard{x.mtx};
+    auto i = x.actors.find(key);
+    if (i != x.actors.end()) {
       ref.swap(i->second);
-      entries_.erase(i);
+      x.actors.erase(i);
     }
   }
 }
@@ -80,6 +83,10 @@ size_t actor_registry::inc_running() {
   return ++*system_.base_metrics().running_actors;
 }
 
+void actor_registry::inc_running(size_t n) {
+  system_.base_metrics().running_actors->inc(static_cast<int64_t>(n));
+}
+
 size_t actor_registry::running() const {
   return static_cast<size_t>(system_.base_metrics().running_actors->value());
 }
@@ -144,9 +151,14 @@ void actor_registry::start() {
 }
 
 void actor_registry::stop() {
-  {
-    exclusive_guard guard{instances_mtx_};
-    entries_.clear();
+  for (auto& x : shards_) {
+    // Clearing a shard may release the last reference to an actor, which then
+    // calls erase(key) on the same shard.
+    entries tmp;
+    {
+      std::unique_lock guard{x.mtx};
+      tmp.swap(x.actors);
+    }
   }
   {
     exclusive_guard guard{named_entries_mtx_};
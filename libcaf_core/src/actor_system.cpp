@@ -204,6 +204,10 @@ actor_system::networking_module::~networking_module() {
 namespace {
 
 auto make_base_metrics(telemetry::metric_registry& reg) {
+  auto yields = reg.counter_family("caf.system", "forced-yields", {"reason"},
+                                   "Number of runs that actors stopped with "
+                                   "messages left in their mailbox.",
+                                   "1", true);
   return actor_system::base_metrics_t{
     // Initialize the base metrics.
     reg.counter_singleton("caf.system", "rejected-messages",
@@ -214,6 +218,19 @@ auto make_base_metrics(telemetry::metric_registry& reg) {
                         "Number of currently running actors."),
     reg.gauge_singleton("caf.system", "queued-messages",
                         "Number of messages in all mailboxes.", "1", true),
+    yields->get_or_add({{"reason", "max-throughput"}}),
+    yields->get_or_add({{"reason", "max-run-time"}}),
+    reg.counter_singleton("caf.system", "dropped-messages",
+                          "Number of messages dropped by bounded mailboxes.",
+                          "1", true),
+    reg.counter_singleton("caf.system", "conflated-messages",
+                          "Number of messages merged by conflating mailboxes.",
+                          "1", true),
+    reg.gauge_singleton("caf.system", "private-threads",
+                        "Number of threads for detached actors."),
+    reg.counter_singleton("caf.system", "reused-private-threads",
+                          "Number of detached actors started on idle threads.",
+                          "1", true),
   };
 }
 
@@ -244,6 +261,8 @@ auto make_actor_metric_families(telemetry::metric_registry& reg) {
       "Time a message waits in the mailbox before processing.", "seconds"),
     reg.gauge_family("caf.actor", "mailbox-size", {"name"},
                      "Number of messages in the mailbox."),
+    reg.gauge_family("caf.actor", "pending-requests", {"name"},
+                     "Number of responses the actor waits for."),
     {
       reg.counter_family("caf.actor.stream", "processed-elements",
                          {"name", "type"},
@@ -291,6 +310,14 @@ actor_system::actor_system(actor_system_config& cfg)
   if (auto lst = get_as<string_list>(cfg,
                                      "caf.metrics-filters.actors.excludes"))
     metrics_actors_excludes_ = std::move(*lst);
+  if (auto rates = get_if<settings>(&cfg,
+                                    "caf.metrics-filters.actors.sample-rates"))
+    for (auto& [glob, val] : *rates) {
+      if (auto rate = get_as<size_t>(val); rate && *rate > 0)
+        metrics_actors_sample_rates_.emplace_back(glob, *rate);
+      else
+        CAF_LOG_WARNING("invalid sample rate for" << glob);
+    }
   if (!metrics_actors_includes_.empty())
     actor_metric_families_ = make_actor_metric_families(metrics_);
   // Spin up modules.
@@ -348,6 +375,24 @@ actor_system::actor_system(actor_system_config& cfg)
         sched.reset(new test_coordinator(*this));
     }
   }
+  // Create the named scheduler pools. Deterministic testing runs all actors
+  // in the test coordinator instead.
+  auto pools = get_if<settings>(&cfg, "caf.scheduler.pools");
+  if (pools != nullptr && !dynamic_cast<test_coordinator*>(sched.get())) {
+    for (auto& [name, pool_cfg] : *pools) {
+      if (name == "default" || !holds_alternative<settings>(pool_cfg)) {
+        std::cerr << "[WARNING] ignore invalid scheduler pool "
+                  << deep_to_string(name) << std::endl;
+        continue;
+      }
+      auto pool_policy = get_or(get<settings>(pool_cfg), "policy",
+                                defaults::scheduler::policy);
+      if (pool_policy == "sharing")
+        pools_.emplace_back(new share(*this, name));
+      else
+        pools_.emplace_back(new steal(*this, name));
+    }
+  }
   // Initialize state for each module and give each module the opportunity to
   // adapt the system configuration.
   logger_->init(cfg);
@@ -355,6 +400,8 @@ actor_system::actor_system(actor_system_config& cfg)
   for (auto& mod : modules_)
     if (mod)
       mod->init(cfg);
+  for (auto& pool : pools_)
+    pool->init(cfg);
   groups_.init(cfg);
   // Spawn config and spawn servers (lazily to not access the scheduler yet).
   static constexpr auto Flags = hidden + lazy_init;
@@ -368,6 +415,8 @@ actor_system::actor_system(actor_system_config& cfg)
   for (auto& mod : modules_)
     if (mod)
       mod->start();
+  for (auto& pool : pools_)
+    pool->start();
   groups_.start();
   logger_->start();
 }
@@ -387,6 +436,9 @@ actor_system::~actor_system() {
     drop(config_serv_);
     // group module is the first one, relies on MM
     groups_.stop();
+    // named pools run on top of the default scheduler
+    for (auto i = pools_.rbegin(); i != pools_.rend(); ++i)
+      (*i)->stop();
     // stop modules in reverse order
     for (auto i = modules_.rbegin(); i != modules_.rend(); ++i) {
       auto& ptr = *i;
@@ -412,6 +464,30 @@ scheduler::abstract_coordinator& actor_system::scheduler() {
   return *static_cast<ptr>(modules_[module::scheduler].get());
 }
 
+scheduler::abstract_coordinator*
+actor_system::scheduler_pool(std::string_view name) {
+  using ptr = scheduler::abstract_coordinator*;
+  for (auto& pool : pools_) {
+    auto sched = static_cast<ptr>(pool.get());
+    if (sched->pool_name() == name)
+      return sched;
+  }
+  return nullptr;
+}
+
+scheduler::abstract_coordinator*
+actor_system::spawn_pool(std::string_view name) {
+  if (name == "default")
+    return nullptr;
+  auto result = scheduler_pool(name);
+  if (result == nullptr) {
+    // Falling back to the default scheduler would silently break isolation.
+    auto msg = "unknown scheduler pool: " + std::string{name};
+    CAF_RAISE_ERROR(std::invalid_argument, msg.c_str());
+  }
+  return result;
+}
+
 caf::logger& actor_system::logger() {
   return *logger_;
 }
@@ -465,6 +541,10 @@ actor_id actor_system::next_actor_id() {
   return ++ids_;
 }
 
+actor_id actor_system::next_actor_ids(size_t n) {
+  return ids_.fetch_add(n) + 1;
+}
+
 actor_id actor_system::latest_actor_id() const {
   return ids_.load();
 }
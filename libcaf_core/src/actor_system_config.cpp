@@ -54,22 +54,38 @@ actor_system_config::actor_system_config()
     .add<string>("policy", "'stealing' (default) or 'sharing'")
     .add<size_t>("max-threads", "maximum number of worker threads")
     .add<size_t>("max-throughput", "nr. of messages actors can consume per run")
-    .add<bool>("enable-profiling", "enables profiler output")
-    .add<timespan>("profiling-resolution", "data collection rate")
-    .add<string>("profiling-output-file", "output file for the profiler");
+    .add<timespan>("max-run-time",
+                   "max. time actors can spend in handlers per run (0: off)")
+    .add<size_t>("drr-quantum", "nr. of messages per round and mailbox queue")
+    .add<size_t>("max-drr-quantum",
+                 "max. nr. of messages per round for backlogged actors")
+    .add<timespan>("stall-threshold",
+                   "reports workers running a single job this long (0: off)")
+    .add<bool>("replace-stalled-workers",
+               "starts a stand-in thread for each stalled worker")
+    .add<bool>("pin-workers", "pins worker threads to CPUs (Linux only)")
+    .add<string>("trace-file", "writes a Chrome trace of all workers to file")
+    .add<size_t>("trace-buffer-size", "nr. of trace events per worker buffer")
+    .add<timespan>("trace-flush-interval",
+                   "time between writing buffered trace events");
+  opt_group(custom_options_, "caf.private-threads")
+    .add<size_t>("max-idle", "max. nr. of idle threads for detached actors")
+    .add<timespan>("idle-timeout", "time until stopping an idle thread");
   opt_group(custom_options_, "caf.work-stealing")
     .add<size_t>("aggressive-poll-attempts", "nr. of aggressive steal attempts")
     .add<size_t>("aggressive-steal-interval",
                  "frequency of aggressive steal attempts")
+    .add<size_t>("aggressive-steal-batch-size",
+                 "max. nr. of jobs per aggressive steal attempt")
     .add<size_t>("moderate-poll-attempts", "nr. of moderate steal attempts")
     .add<size_t>("moderate-steal-interval",
                  "frequency of moderate steal attempts")
     .add<timespan>("moderate-sleep-duration",
                    "sleep duration between moderate steal attempts")
-    .add<size_t>("relaxed-steal-interval",
-                 "frequency of relaxed steal attempts")
-    .add<timespan>("relaxed-sleep-duration",
-                   "sleep duration between relaxed steal attempts");
+    .add<size_t>("moderate-steal-batch-size",
+                 "max. nr. of jobs per moderate steal attempt")
+    .add<size_t>("max-next-slot-runs",
+                 "max. nr. of consecutive runs from the next-to-run slot");
   opt_group{custom_options_, "caf.logger"} //
     .add<bool>("inline-output", "disable logger thread (for testing only!)");
   opt_group{custom_options_, "caf.logger.file"}
@@ -84,7 +100,8 @@ actor_system_config::actor_system_config()
     .add<string_list>("excluded-components", "excluded components on console");
   opt_group{custom_options_, "caf.metrics-filters.actors"}
     .add<string_list>("includes", "selects actors for run-time metrics")
-    .add<string_list>("excludes", "excludes actors from run-time metrics");
+    .add<string_list>("excludes", "excludes actors from run-time metrics")
+    .add<settings>("sample-rates", "samples 1 in N messages per actor name");
 }
 
 settings actor_system_config::dump_content() const {
@@ -95,26 +112,46 @@ settings actor_system_config::dump_content() const {
   put_missing(scheduler_group, "policy", defaults::scheduler::policy);
   put_missing(scheduler_group, "max-throughput",
               defaults::scheduler::max_throughput);
-  put_missing(scheduler_group, "enable-profiling", false);
-  put_missing(scheduler_group, "profiling-resolution",
-              defaults::scheduler::profiling_resolution);
-  put_missing(scheduler_group, "profiling-output-file", std::string{});
+  put_missing(scheduler_group, "max-run-time",
+              defaults::scheduler::max_run_time);
+  put_missing(scheduler_group, "drr-quantum",
+              defaults::scheduler::drr_quantum);
+  put_missing(scheduler_group, "max-drr-quantum",
+              defaults::scheduler::max_drr_quantum);
+  put_missing(scheduler_group, "stall-threshold",
+              defaults::scheduler::stall_threshold);
+  put_missing(scheduler_group, "replace-stalled-workers",
+              defaults::scheduler::replace_stalled_workers);
+  put_missing(scheduler_group, "pin-workers", defaults::scheduler::pin_workers);
+  put_missing(scheduler_group, "trace-file", defaults::scheduler::trace_file);
+  put_missing(scheduler_group, "trace-buffer-size",
+              defaults::scheduler::trace_buffer_size);
+  put_missing(scheduler_group, "trace-flush-interval",
+              defaults::scheduler::trace_flush_interval);
+  // -- private thread parameters
+  auto& private_threads_group = caf_group["private-threads"].as_dictionary();
+  put_missing(private_threads_group, "max-idle",
+              defaults::private_threads::max_idle);
+  put_missing(private_threads_group, "idle-timeout",
+              defaults::private_threads::idle_timeout);
   // -- work-stealing parameters
   auto& work_stealing_group = caf_group["work-stealing"].as_dictionary();
   put_missing(work_stealing_group, "aggressive-poll-attempts",
               defaults::work_stealing::aggressive_poll_attempts);
   put_missing(work_stealing_group, "aggressive-steal-interval",
               defaults::work_stealing::aggressive_steal_interval);
+  put_missing(work_stealing_group, "aggressive-steal-batch-size",
+              defaults::work_stealing::aggressive_steal_batch_size);
   put_missing(work_stealing_group, "moderate-poll-attempts",
               defaults::work_stealing::moderate_poll_attempts);
   put_missing(work_stealing_group, "moderate-steal-interval",
               defaults::work_stealing::moderate_steal_interval);
   put_missing(work_stealing_group, "moderate-sleep-duration",
               defaults::work_stealing::moderate_sleep_duration);
-  put_missing(work_stealing_group, "relaxed-steal-interval",
-              defaults::work_stealing::relaxed_steal_interval);
-  put_missing(work_stealing_group, "relaxed-sleep-duration",
-              defaults::work_stealing::relaxed_sleep_duration);
+  put_missing(work_stealing_group, "moderate-steal-batch-size",
+              defaults::work_stealing::moderate_steal_batch_size);
+  put_missing(work_stealing_group, "max-next-slot-runs",
+              defaults::work_stealing::max_next_slot_runs);
   // -- logger parameters
   auto& logger_group = caf_group["logger"].as_dictionary();
   put_missing(logger_group, "inline-output", false);
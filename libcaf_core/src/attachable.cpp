@@ -34,6 +34,10 @@ bool attachable::matches(const token&) {
   return false;
 }
 
+size_t attachable::token_type() const noexcept {
+  return token::anonymous;
+}
+
 attachable_ptr attachable::make_monitor(actor_addr observed,
                                         actor_addr observer,
                                         message_priority prio) {
@@ -57,15 +57,19 @@ bool blocking_actor::enqueue(mailbox_element_ptr ptr, execution_unit*) {
   CAF_LOG_SEND_EVENT(ptr);
   auto mid = ptr->mid;
   auto src = ptr->sender;
+  if (mailbox_bound_ && !reserve_mailbox_slot(*ptr))
+    return false;
+  count_queued_messages();
   auto collects_metrics = getf(abstract_actor::collects_metrics_flag);
   if (collects_metrics) {
-    ptr->set_enqueue_time();
+    sample_enqueue_time(*ptr);
     metrics_.mailbox_size->inc();
   }
   // returns false if mailbox has been closed
   if (!mailbox().synchronized_push_back(mtx_, cv_, std::move(ptr))) {
     CAF_LOG_REJECT_EVENT();
     home_system().base_metrics().rejected_messages->inc();
+    release_mailbox_slots();
     if (collects_metrics)
       metrics_.mailbox_size->dec();
     if (mid.is_request()) {
@@ -263,22 +267,29 @@ blocking_actor::mailbox_visitor::operator()(mailbox_element& x) {
     } else {
       CAF_AFTER_PROCESSING(self, invoke_message_result::consumed);
       CAF_LOG_FINALIZE_EVENT();
+      self->release_mailbox_slots();
     }
     return result;
   } else {
-    auto t0 = std::chrono::steady_clock::now();
-    auto mbox_time = x.seconds_until(t0);
+    // Only messages with a timestamp contribute to the histograms.
+    auto sampled = x.has_enqueue_time();
+    auto t0 = sampled ? std::chrono::steady_clock::now()
+                      : std::chrono::steady_clock::time_point{};
+    auto mbox_time = sampled ? x.seconds_until(t0) : 0.0;
     auto result = body();
     if (result == intrusive::task_result::skip) {
       CAF_AFTER_PROCESSING(self, invoke_message_result::skipped);
       CAF_LOG_SKIP_EVENT();
-      auto& builtins = self->builtin_metrics();
-      telemetry::timer::observe(builtins.processing_time, t0);
-      builtins.mailbox_time->observe(mbox_time);
-      builtins.mailbox_size->dec();
     } else {
       CAF_AFTER_PROCESSING(self, invoke_message_result::consumed);
       CAF_LOG_FINALIZE_EVENT();
+      auto& builtins = self->builtin_metrics();
+      if (sampled) {
+        telemetry::timer::observe(builtins.processing_time, t0);
+        builtins.mailbox_time->observe(mbox_time);
+      }
+      builtins.mailbox_size->dec();
+      self->release_mailbox_slots();
     }
     return result;
   }
@@ -316,6 +327,10 @@ void blocking_actor::receive_impl(receive_cond& rcc, message_id mid,
           return;
       }
     }
+    if (mailbox_bound_) {
+      mailbox().fetch_more();
+      drop_oldest_messages();
+    }
     mailbox_.new_round(3, f);
   } while (!done);
 }
@@ -332,14 +347,40 @@ mailbox_element_ptr blocking_actor::dequeue() {
   mailbox().flush_cache();
   await_data();
   mailbox().fetch_more();
+  if (mailbox_bound_)
+    drop_oldest_messages();
   auto& qs = mailbox().queue().queues();
   auto result = get<mailbox_policy::urgent_queue_index>(qs).take_front();
   if (!result)
     result = get<mailbox_policy::normal_queue_index>(qs).take_front();
   CAF_ASSERT(result != nullptr);
+  release_mailbox_slots();
   return result;
 }
 
+void blocking_actor::drop_oldest_messages() {
+  // Responses and urgent messages may exceed the capacity with any policy.
+  // Only drop_oldest makes room for them by dropping ordinary messages.
+  if (mailbox_bound_->policy() != mailbox_overflow_policy::drop_oldest)
+    return;
+  auto& qs = mailbox().queue().queues();
+  auto& nq = get<mailbox_policy::normal_queue_index>(qs);
+  size_t dropped = 0;
+  for (auto n = mailbox_bound_->excess(); n > 0; --n) {
+    auto ptr = nq.take_front();
+    if (!ptr)
+      break;
+    CAF_LOG_DEBUG("mailbox full, drop message:" << CAF_ARG(*ptr));
+    ++dropped;
+  }
+  if (dropped > 0) {
+    count_dropped_messages(dropped);
+    release_mailbox_slots(dropped);
+    if (getf(abstract_actor::collects_metrics_flag))
+      metrics_.mailbox_size->dec(static_cast<int64_t>(dropped));
+  }
+}
+
 void blocking_actor::varargs_tup_receive(receive_cond& rcc, message_id mid,
                                          std::tuple<behavior&>& tup) {
   using namespace detail;
@@ -374,6 +415,8 @@ size_t blocking_actor::attach_functor(const strong_actor_ptr& ptr) {
 bool blocking_actor::cleanup(error&& fail_state, execution_unit* host) {
   if (!mailbox_.closed()) {
     mailbox_.close();
+    if (mailbox_bound_)
+      mailbox_bound_->close();
     // TODO: messages that are stuck in the cache can get lost
     detail::sync_request_bouncer bounce{fail_state};
     auto dropped = mailbox_.queue().new_round(1000, bounce).consumed_items;
@@ -39,6 +39,16 @@ bool default_attachable::matches(const token& what) {
   return ref.observer == observer_ && ref.type == type_;
 }
 
+size_t default_attachable::token_type() const noexcept {
+  return attachable::token::observer;
+}
+
+void default_attachable::notify(const strong_actor_ptr& sender,
+                                const message& msg, execution_unit* host) {
+  if (auto observer = actor_cast<strong_actor_ptr>(observer_))
+    observer->enqueue(sender, make_message_id(priority_), msg, host);
+}
+
 default_attachable::default_attachable(actor_addr observed, actor_addr observer,
                                        observe_type type,
                                        message_priority priority)
@@ -0,0 +1,171 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/actor_storage_cache.hpp"
+
+#include <array>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace caf::detail {
+
+namespace {
+
+constexpr size_t num_size_classes = actor_storage_cache::max_block_size
+                                    / actor_storage_cache::granularity;
+
+/// Number of blocks that threads move to or from the depot at once.
+constexpr size_t batch_size = 16;
+
+/// Overlays the memory of a released block.
+struct free_block {
+  free_block* next;
+};
+
+/// Links up to `batch_size` blocks.
+struct batch {
+  free_block* head = nullptr;
+  size_t size = 0;
+
+  void push(free_block* blk) noexcept {
+    blk->next = head;
+    head = blk;
+    ++size;
+  }
+
+  free_block* pop() noexcept {
+    auto blk = head;
+    head = blk->next;
+    --size;
+    return blk;
+  }
+};
+
+/// Stores full batches for all threads.
+struct depot {
+  std::mutex mtx;
+  std::array<std::vector<batch>, num_size_classes> batches;
+};
+
+depot& global_depot() {
+  // Intentionally leaked: static destructors may still release actors.
+  static auto* instance = new depot;
+  return *instance;
+}
+
+size_t size_class_of(size_t size) noexcept {
+  return (size - 1) / actor_storage_cache::granularity;
+}
+
+size_t block_size_of(size_t size_class) noexcept {
+  return (size_class + 1) * actor_storage_cache::granularity;
+}
+
+/// Stores the free lists of a single thread.
+class thread_cache {
+public:
+  ~thread_cache() {
+    auto& dp = global_depot();
+    std::unique_lock guard{dp.mtx};
+    for (size_t size_class = 0; size_class < num_size_classes; ++size_class)
+      if (auto& xs = lists_[size_class]; xs.size > 0)
+        dp.batches[size_class].push_back(xs);
+  }
+
+  void* allocate(size_t size_class) {
+    auto& xs = lists_[size_class];
+    if (xs.head == nullptr && !refill(xs, size_class))
+      return ::operator new(block_size_of(size_class));
+    return xs.pop();
+  }
+
+  void release(void* ptr, size_t size_class) noexcept {
+    auto& xs = lists_[size_class];
+    if (xs.size == 2 * batch_size)
+      spill(xs, size_class);
+    xs.push(static_cast<free_block*>(ptr));
+  }
+
+private:
+  // Takes a batch from the depot.
+  bool refill(batch& xs, size_t size_class) {
+    auto& dp = global_depot();
+    std::unique_lock guard{dp.mtx};
+    auto& batches = dp.batches[size_class];
+    if (batches.empty())
+      return false;
+    xs = batches.back();
+    batches.pop_back();
+    return true;
+  }
+
+  // Moves `batch_size` blocks to the depot.
+  void spill(batch& xs, size_t size_class) noexcept {
+    batch spilled;
+    while (spilled.size < batch_size)
+      spilled.push(xs.pop());
+    auto& dp = global_depot();
+    std::unique_lock guard{dp.mtx};
+    try {
+      dp.batches[size_class].push_back(spilled);
+    } catch (...) {
+      while (spilled.head != nullptr)
+        ::operator delete(spilled.pop());
+    }
+  }
+
+  std::array<batch, num_size_classes> lists_;
+};
+
+thread_local thread_cache* local_cache_ptr = nullptr;
+
+thread_local bool local_cache_released = false;
+
+/// Destroys the cache of the current thread when the thread terminates.
+struct cache_guard {
+  thread_cache cache;
+
+  cache_guard() {
+    local_cache_ptr = &cache;
+  }
+
+  ~cache_guard() {
+    local_cache_ptr = nullptr;
+    local_cache_released = true;
+  }
+};
+
+/// Returns the cache of the current thread or `nullptr` while the thread shuts
+/// down.
+thread_cache* local_cache() noexcept {
+  if (local_cache_ptr != nullptr)
+    return local_cache_ptr;
+  if (local_cache_released)
+    return nullptr;
+  static thread_local cache_guard guard;
+  return local_cache_ptr;
+}
+
+} // namespace
+
+void* actor_storage_cache::allocate(size_t size) {
+  if (enabled && size > 0 && size <= max_block_size)
+    if (auto cache = local_cache())
+      return cache->allocate(size_class_of(size));
+  return ::operator new(size);
+}
+
+void actor_storage_cache::deallocate(void* ptr, size_t size) noexcept {
+  if (ptr == nullptr)
+    return;
+  if (enabled && size > 0 && size <= max_block_size)
+    if (auto cache = local_cache()) {
+      cache->release(ptr, size_class_of(size));
+      return;
+    }
+  ::operator delete(ptr);
+}
+
+} // namespace caf::detail
@@ -24,6 +24,10 @@ public:
     return second->handle_timeout();
   }
 
+  bool accepts(type_id_list xs) const noexcept override {
+    return first->accepts(xs) || second->accepts(xs);
+  }
+
   combinator(pointer p0, const pointer& p1)
     : behavior_impl(p1->timeout()), first(std::move(p0)), second(p1) {
     // nop
@@ -77,6 +81,10 @@ void behavior_impl::handle_timeout() {
   // nop
 }
 
+bool behavior_impl::accepts(type_id_list) const noexcept {
+  return true;
+}
+
 behavior_impl::pointer behavior_impl::or_else(const pointer& other) {
   CAF_ASSERT(other != nullptr);
   return make_counted<combinator>(this, other);
@@ -0,0 +1,200 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/cpu_topology.hpp"
+
+#include "caf/config.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <tuple>
+
+#ifdef CAF_LINUX
+#  include <pthread.h>
+#  include <sched.h>
+#endif // CAF_LINUX
+
+namespace caf::detail {
+
+namespace {
+
+[[maybe_unused]] std::string read_file(const std::string& path) {
+  std::ifstream in{path};
+  if (!in)
+    return {};
+  return std::string{std::istreambuf_iterator<char>{in},
+                     std::istreambuf_iterator<char>{}};
+}
+
+bool parse_cpu_id(std::string_view str, size_t& result) {
+  if (str.empty())
+    return false;
+  result = 0;
+  for (auto ch : str) {
+    if (ch < '0' || ch > '9')
+      return false;
+    result = result * 10 + static_cast<size_t>(ch - '0');
+  }
+  return true;
+}
+
+} // namespace
+
+std::string_view to_label(cpu_locality x) noexcept {
+  switch (x) {
+    case cpu_locality::same_l3:
+      return "l3";
+    case cpu_locality::same_node:
+      return "node";
+    default:
+      return "remote";
+  }
+}
+
+cpu_topology::cpu_topology(std::vector<cpu_location> cpus)
+  : cpus_(std::move(cpus)) {
+  auto key = [](const cpu_location& x) {
+    return std::make_tuple(x.node, x.l3, x.cpu);
+  };
+  std::sort(cpus_.begin(), cpus_.end(),
+            [key](const cpu_location& x, const cpu_location& y) {
+              return key(x) < key(y);
+            });
+}
+
+cpu_topology cpu_topology::read(const std::string& sysfs_dir) {
+#ifdef CAF_LINUX
+  std::vector<size_t> ids;
+  if (!parse_cpu_list(read_file(sysfs_dir + "/cpu/online"), ids)
+      || ids.empty())
+    return {};
+  std::vector<cpu_location> cpus;
+  cpus.reserve(ids.size());
+  for (auto id : ids) {
+    cpu_location loc{id, id, 0};
+    // Find the L3 cache (if any) and use the lowest CPU that shares it as ID.
+    auto prefix = sysfs_dir + "/cpu/cpu" + std::to_string(id) + "/cache/index";
+    for (size_t index = 0;; ++index) {
+      auto dir = prefix + std::to_string(index);
+      auto level = read_file(dir + "/level");
+      if (level.empty())
+        break;
+      if (level.front() == '3') {
+        std::vector<size_t> shared;
+        if (parse_cpu_list(read_file(dir + "/shared_cpu_list"), shared)
+            && !shared.empty())
+          loc.l3 = *std::min_element(shared.begin(), shared.end());
+        break;
+      }
+    }
+    cpus.emplace_back(loc);
+  }
+  // Systems without NUMA support have no node directory, in which case all
+  // CPUs belong to node 0.
+  std::vector<size_t> nodes;
+  if (parse_cpu_list(read_file(sysfs_dir + "/node/online"), nodes)) {
+    for (auto node : nodes) {
+      std::vector<size_t> node_cpus;
+      auto path = sysfs_dir + "/node/node" + std::to_string(node) + "/cpulist";
+      if (!parse_cpu_list(read_file(path), node_cpus))
+        continue;
+      for (auto& loc : cpus)
+        if (std::find(node_cpus.begin(), node_cpus.end(), loc.cpu)
+            != node_cpus.end())
+          loc.node = node;
+    }
+  }
+  return cpu_topology{std::move(cpus)};
+#else
+  static_cast<void>(sysfs_dir);
+  return {};
+#endif
+}
+
+void cpu_topology::restrict_to(const std::vector<size_t>& allowed) {
+  auto is_forbidden = [&allowed](const cpu_location& x) {
+    return std::find(allowed.begin(), allowed.end(), x.cpu) == allowed.end();
+  };
+  cpus_.erase(std::remove_if(cpus_.begin(), cpus_.end(), is_forbidden),
+              cpus_.end());
+}
+
+void cpu_topology::rotate(size_t n) {
+  if (!cpus_.empty())
+    std::rotate(cpus_.begin(), cpus_.begin() + n % cpus_.size(), cpus_.end());
+}
+
+cpu_locality cpu_topology::locality(const cpu_location& x,
+                                    const cpu_location& y) noexcept {
+  if (x.node != y.node)
+    return cpu_locality::remote;
+  if (x.l3 != y.l3)
+    return cpu_locality::same_node;
+  return cpu_locality::same_l3;
+}
+
+bool parse_cpu_list(std::string_view str, std::vector<size_t>& result) {
+  // Drop trailing whitespace, e.g., the newline at the end of sysfs files.
+  while (!str.empty()
+         && (str.back() == '\n' || str.back() == ' ' || str.back() == '\t'))
+    str.remove_suffix(1);
+  if (str.empty())
+    return false;
+  std::vector<size_t> ids;
+  for (;;) {
+    auto sep = str.find(',');
+    auto item = str.substr(0, sep);
+    size_t first = 0;
+    size_t last = 0;
+    if (auto dash = item.find('-'); dash != std::string_view::npos) {
+      if (!parse_cpu_id(item.substr(0, dash), first)
+          || !parse_cpu_id(item.substr(dash + 1), last) || first > last)
+        return false;
+    } else if (parse_cpu_id(item, first)) {
+      last = first;
+    } else {
+      return false;
+    }
+    for (auto id = first; id <= last; ++id)
+      ids.emplace_back(id);
+    if (sep == std::string_view::npos)
+      break;
+    str.remove_prefix(sep + 1);
+  }
+  result.insert(result.end(), ids.begin(), ids.end());
+  return true;
+}
+
+bool get_thread_affinity(std::vector<size_t>& result) {
+#ifdef CAF_LINUX
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  if (pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpus) != 0)
+    return false;
+  for (size_t cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+    if (CPU_ISSET(cpu, &cpus))
+      result.emplace_back(cpu);
+  return true;
+#else
+  static_cast<void>(result);
+  return false;
+#endif
+}
+
+bool set_thread_affinity(size_t cpu) {
+#ifdef CAF_LINUX
+  if (cpu >= CPU_SETSIZE)
+    return false;
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  CPU_SET(cpu, &cpus);
+  return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpus) == 0;
+#else
+  static_cast<void>(cpu);
+  return false;
+#endif
+}
+
+} // namespace caf::detail
@@ -0,0 +1,64 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/event_count.hpp"
+
+namespace caf::detail {
+
+namespace {
+
+using guard_type = std::unique_lock<std::mutex>;
+
+} // namespace
+
+event_count::key_type event_count::prepare_wait() noexcept {
+  auto prev = state_.fetch_add(1, std::memory_order_seq_cst);
+  // Make sure that subsequent checks for work cannot move before the update.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  return static_cast<key_type>(prev >> epoch_shift);
+}
+
+void event_count::cancel_wait() noexcept {
+  state_.fetch_sub(1, std::memory_order_seq_cst);
+}
+
+void event_count::wait(key_type key) {
+  auto epoch = [this] {
+    return static_cast<key_type>(state_.load(std::memory_order_acquire)
+                                 >> epoch_shift);
+  };
+  { // Lifetime scope of the guard.
+    guard_type guard{mtx_};
+    while (epoch() == key)
+      cv_.wait(guard);
+  }
+  state_.fetch_sub(1, std::memory_order_seq_cst);
+}
+
+void event_count::notify_one() {
+  if (!has_waiters())
+    return;
+  state_.fetch_add(epoch_inc, std::memory_order_acq_rel);
+  // Acquiring the mutex once makes sure that a waiter is either blocked on the
+  // condition or still going to observe the new epoch.
+  { guard_type guard{mtx_}; }
+  cv_.notify_one();
+}
+
+void event_count::notify_all() {
+  if (!has_waiters())
+    return;
+  state_.fetch_add(epoch_inc, std::memory_order_acq_rel);
+  { guard_type guard{mtx_}; }
+  cv_.notify_all();
+}
+
+bool event_count::has_waiters() const noexcept {
+  // Pairs with the fence in prepare_wait: either the waiter sees the work that
+  // the caller published before calling notify or we see the waiter.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  return (state_.load(std::memory_order_relaxed) & waiter_mask) != 0;
+}
+
+} // namespace caf::detail
@@ -0,0 +1,54 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/mailbox_bound.hpp"
+
+namespace caf::detail {
+
+mailbox_bound::mailbox_bound(size_t capacity,
+                             mailbox_overflow_policy policy) noexcept
+  : capacity_(capacity), policy_(policy), size_(0), waiters_(0),
+    closed_(false) {
+  // nop
+}
+
+bool mailbox_bound::try_reserve() noexcept {
+  // Note: sequential consistency for the load pairs with `release`, which
+  //       decrements the size before checking for waiters.
+  auto n = size_.load();
+  do {
+    if (n >= capacity_)
+      return false;
+  } while (!size_.compare_exchange_weak(n, n + 1));
+  return true;
+}
+
+bool mailbox_bound::reserve_or_wait() {
+  if (try_reserve())
+    return true;
+  std::unique_lock guard{mtx_};
+  // Announcing ourselves before checking the size again makes sure that
+  // `release` either sees the waiter or we see the released slot.
+  waiters_.fetch_add(1);
+  while (!closed_ && !try_reserve())
+    cv_.wait(guard);
+  waiters_.fetch_sub(1);
+  return !closed_;
+}
+
+void mailbox_bound::release(size_t n) noexcept {
+  size_.fetch_sub(n);
+  if (waiters_.load() > 0) {
+    std::unique_lock guard{mtx_};
+    cv_.notify_all();
+  }
+}
+
+void mailbox_bound::close() {
+  std::unique_lock guard{mtx_};
+  closed_ = true;
+  cv_.notify_all();
+}
+
+} // namespace caf::detail
@@ -0,0 +1,68 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/mailbox_conflation.hpp"
+
+#include <algorithm>
+
+#include "caf/mailbox_element.hpp"
+
+namespace caf::detail {
+
+void mailbox_conflation::add(type_id_list types, key_function fn) {
+  auto pred = [types](const entry& x) { return x.types == types; };
+  if (auto i = std::find_if(entries_.begin(), entries_.end(), pred);
+      i != entries_.end()) {
+    i->fn = std::move(fn);
+    i->latest.clear();
+    return;
+  }
+  entries_.push_back(entry{types, std::move(fn), {}});
+}
+
+bool mailbox_conflation::conflate(mailbox_element& x) {
+  auto e = find(x);
+  if (e == nullptr)
+    return false;
+  auto [i, added] = e->latest.emplace(e->fn(x.payload), &x);
+  if (added || i->second == &x)
+    return false;
+  // Note: the older message keeps its enqueue time, because it has been
+  //       waiting for its key since then.
+  auto& y = *i->second;
+  y.sender = std::move(x.sender);
+  y.mid = x.mid;
+  y.stages = std::move(x.stages);
+  y.payload = std::move(x.payload);
+#ifdef CAF_ENABLE_ACTOR_PROFILER
+  y.tracing_id = std::move(x.tracing_id);
+#endif
+  return true;
+}
+
+void mailbox_conflation::erase(const mailbox_element& x) {
+  if (auto e = find(x)) {
+    if (auto i = e->latest.find(e->fn(x.payload));
+        i != e->latest.end() && i->second == &x)
+      e->latest.erase(i);
+  }
+}
+
+void mailbox_conflation::clear() noexcept {
+  for (auto& x : entries_)
+    x.latest.clear();
+}
+
+mailbox_conflation::entry*
+mailbox_conflation::find(const mailbox_element& x) noexcept {
+  if (!x.mid.is_async())
+    return nullptr;
+  auto types = x.payload.types();
+  for (auto& e : entries_)
+    if (e.types == types)
+      return &e;
+  return nullptr;
+}
+
+} // namespace caf::detail
@@ -42,14 +42,13 @@ void private_thread::resume(resumable* ptr) {
   cv_.notify_all();
 }
 
-bool private_thread::stop() {
+void private_thread::stop() {
   {
     std::unique_lock<std::mutex> guard{mtx_};
     shutdown_ = true;
     cv_.notify_all();
   }
   thread_.join();
-  return true;
 }
 
 std::pair<resumable*, bool> private_thread::await() {
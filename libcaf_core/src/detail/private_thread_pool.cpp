@@ -5,8 +5,12 @@
 #include "caf/detail/private_thread_pool.hpp"
 
 #include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
 #include "caf/config.hpp"
+#include "caf/defaults.hpp"
 #include "caf/detail/private_thread.hpp"
+#include "caf/telemetry/counter.hpp"
+#include "caf/telemetry/gauge.hpp"
 #include "caf/thread_owner.hpp"
 
 namespace caf::detail {
@@ -16,48 +20,73 @@ private_thread_pool::node::~node() {
 }
 
 void private_thread_pool::start() {
+  namespace pt = defaults::private_threads;
+  auto& cfg = sys_->config();
+  max_idle_ = get_or(cfg, "caf.private-threads.max-idle", pt::max_idle);
+  idle_timeout_ = get_or(cfg, "caf.private-threads.idle-timeout",
+                         pt::idle_timeout);
   loop_ = sys_->launch_thread("caf.pool", thread_owner::pool,
                               [this] { run_loop(); });
 }
 
 void private_thread_pool::stop() {
-  struct shutdown_helper : node {
-    bool stop() override {
-      return false;
-    }
-  };
-  auto ptr = new shutdown_helper;
   {
     std::unique_lock guard{mtx_};
-    ++running_;
-    ptr->next = head_;
-    head_ = ptr;
+    shutting_down_ = true;
+    for (auto& x : idle_)
+      push_stop(x.ptr);
+    idle_.clear();
     cv_.notify_all();
   }
   loop_.join();
 }
 
 void private_thread_pool::run_loop() {
-  bool shutting_down = false;
+  auto gauge = sys_->base_metrics().private_threads;
+  std::unique_lock guard{mtx_};
   for (;;) {
-    auto [ptr, remaining] = dequeue();
-    CAF_ASSERT(ptr != nullptr);
-    if (!ptr->stop())
-      shutting_down = true;
-    delete ptr;
-    if (remaining == 0 && shutting_down)
+    expire(clock_type::now());
+    if (head_ != nullptr) {
+      // Stopping a node joins its thread, so we must not hold the lock.
+      auto ptr = head_;
+      head_ = nullptr;
+      guard.unlock();
+      while (ptr != nullptr) {
+        auto next = ptr->next;
+        ptr->stop();
+        delete ptr;
+        gauge->dec();
+        ptr = next;
+      }
+      guard.lock();
+      continue;
+    }
+    if (shutting_down_ && running_ == 0)
       return;
+    if (idle_.empty())
+      cv_.wait(guard);
+    else
+      cv_.wait_until(guard, idle_.front().deadline);
   }
 }
 
 private_thread* private_thread_pool::acquire() {
+  auto& metrics = sys_->base_metrics();
   {
     std::unique_lock guard{mtx_};
     ++running_;
+    if (!idle_.empty()) {
+      auto ptr = idle_.back().ptr;
+      idle_.pop_back();
+      metrics.reused_private_threads->inc();
+      return ptr;
+    }
   }
 #ifdef CAF_ENABLE_EXCEPTIONS
   try {
-    return private_thread::launch(sys_);
+    auto ptr = private_thread::launch(sys_);
+    metrics.private_threads->inc();
+    return ptr;
   } catch (...) {
     {
       std::unique_lock guard{mtx_};
@@ -66,15 +95,28 @@ private_thread* private_thread_pool::acquire() {
     throw;
   }
 #else
-  return private_thread::launch(sys_);
+  auto ptr = private_thread::launch(sys_);
+  metrics.private_threads->inc();
+  return ptr;
 #endif
 }
 
 void private_thread_pool::release(private_thread* ptr) {
+  // Note: the thread may still run the final steps of its current job. Since
+  //       each private thread runs its jobs in order, the next job simply
+  //       waits until the thread becomes available.
   std::unique_lock guard{mtx_};
-  ptr->next = head_;
-  head_ = ptr;
-  cv_.notify_all();
+  --running_;
+  if (shutting_down_ || idle_.size() >= max_idle_) {
+    push_stop(ptr);
+    cv_.notify_all();
+    return;
+  }
+  auto deadline = clock_type::now() + idle_timeout_;
+  idle_.push_back(idle_thread{ptr, deadline});
+  // The loop only needs to adjust its timeout if this is the only idle thread.
+  if (idle_.size() == 1)
+    cv_.notify_all();
 }
 
 size_t private_thread_pool::running() const noexcept {
@@ -82,14 +124,21 @@ size_t private_thread_pool::running() const noexcept {
   return running_;
 }
 
-std::pair<private_thread_pool::node*, size_t> private_thread_pool::dequeue() {
+size_t private_thread_pool::idle() const noexcept {
   std::unique_lock guard{mtx_};
-  while (head_ == nullptr)
-    cv_.wait(guard);
-  auto ptr = head_;
-  head_ = ptr->next;
-  auto remaining = --running_;
-  return {ptr, remaining};
+  return idle_.size();
+}
+
+void private_thread_pool::expire(clock_type::time_point now) {
+  while (!idle_.empty() && idle_.front().deadline <= now) {
+    push_stop(idle_.front().ptr);
+    idle_.pop_front();
+  }
+}
+
+void private_thread_pool::push_stop(node* ptr) noexcept {
+  ptr->next = head_;
+  head_ = ptr;
 }
 
 } // namespace caf::detail
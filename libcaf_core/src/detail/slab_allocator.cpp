@@ -0,0 +1,373 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/slab_allocator.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "caf/config.hpp"
+
+namespace caf::detail {
+
+namespace {
+
+/// Size difference between two neighboring size classes.
+constexpr size_t granularity = 16;
+
+constexpr size_t num_size_classes = slab_allocator::max_block_size
+                                    / granularity;
+
+/// Size of the memory regions that threads split into blocks.
+constexpr size_t slab_size = 64 * 1024;
+
+/// Maximum number of blocks that a thread collects for another thread before
+/// returning them.
+constexpr size_t batch_size = 32;
+
+/// Number of batches per size class, i.e., how many other threads a thread
+/// may collect blocks for at the same time.
+constexpr size_t batches_per_size_class = 4;
+
+class thread_cache;
+
+/// Precedes each block to allow `deallocate` to find the owner of the block.
+/// Aligning the header keeps the blocks aligned as well.
+struct alignas(std::max_align_t) block_header {
+  /// Points to the thread cache that allocated this block, `nullptr` if the
+  /// block came from the heap or `pair_marker()` if the block is part of a
+  /// pair.
+  thread_cache* owner;
+
+  /// Index of the size class or, for blocks of a pair, the distance in bytes
+  /// to the `pair_control` of the pair.
+  size_t size_class;
+};
+
+/// Precedes the two blocks of a pair inside a single allocation.
+struct alignas(std::max_align_t) pair_control {
+  /// Number of blocks that are still in use.
+  std::atomic<size_t> blocks;
+};
+
+/// Tags headers of blocks that are part of a pair.
+char pair_tag;
+
+thread_cache* pair_marker() noexcept {
+  return reinterpret_cast<thread_cache*>(&pair_tag);
+}
+
+/// Rounds `size` up to the next multiple of the header alignment.
+size_t aligned_size(size_t size) noexcept {
+  constexpr auto align = alignof(block_header);
+  return (size + align - 1) / align * align;
+}
+
+/// Overlays the header of a released block.
+struct free_block {
+  free_block* next;
+};
+
+/// Counter that only a single thread writes to.
+class owned_counter {
+public:
+  void inc() noexcept {
+    value_.store(value_.load(std::memory_order_relaxed) + 1,
+                 std::memory_order_relaxed);
+  }
+
+  size_t get() const noexcept {
+    return value_.load(std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<size_t> value_ = 0;
+};
+
+/// Counts heap allocations, which are comparatively rare and slow anyway.
+std::atomic<size_t> heap_allocations;
+
+size_t size_class_of(size_t size) noexcept {
+  return size == 0 ? 0 : (size - 1) / granularity;
+}
+
+size_t block_size_of(size_t size_class) noexcept {
+  return sizeof(block_header) + (size_class + 1) * granularity;
+}
+
+void* heap_allocate(size_t size) noexcept {
+  heap_allocations.fetch_add(1, std::memory_order_relaxed);
+  auto hdr = static_cast<block_header*>(malloc(sizeof(block_header) + size));
+  if (hdr == nullptr)
+    return nullptr;
+  hdr->owner = nullptr;
+  hdr->size_class = 0;
+  return hdr + 1;
+}
+
+/// Stores the pools of a single thread.
+class thread_cache {
+public:
+  /// Blocks that this thread released on behalf of another thread.
+  struct batch {
+    thread_cache* owner = nullptr;
+    free_block* head = nullptr;
+    free_block* tail = nullptr;
+    size_t size = 0;
+  };
+
+  void* allocate(size_t size_class) noexcept {
+    auto& blocks = free_lists_[size_class];
+    if (blocks == nullptr) {
+      blocks = returned_[size_class].exchange(nullptr,
+                                              std::memory_order_acquire);
+      if (blocks == nullptr)
+        return carve(size_class);
+      refills.inc();
+    }
+    hits.inc();
+    auto blk = blocks;
+    blocks = blk->next;
+    return init(reinterpret_cast<block_header*>(blk), size_class);
+  }
+
+  /// Releases a block that this cache allocated.
+  void release(block_header* hdr) noexcept {
+    auto blk = reinterpret_cast<free_block*>(hdr);
+    auto& blocks = free_lists_[hdr->size_class];
+    blk->next = blocks;
+    blocks = blk;
+  }
+
+  /// Collects a block of another cache in a batch.
+  void defer(block_header* hdr) noexcept {
+    remote_frees.inc();
+    auto owner = hdr->owner;
+    auto size_class = hdr->size_class;
+    auto slot = (reinterpret_cast<uintptr_t>(owner) / alignof(thread_cache))
+                % batches_per_size_class;
+    auto& x = batches_[size_class][slot];
+    if (x.owner != owner) {
+      flush(x, size_class);
+      x.owner = owner;
+    }
+    auto blk = reinterpret_cast<free_block*>(hdr);
+    blk->next = x.head;
+    x.head = blk;
+    if (x.tail == nullptr)
+      x.tail = blk;
+    if (++x.size == batch_size)
+      flush(x, size_class);
+  }
+
+  /// Returns the blocks from `head` to `tail` to this cache. Any thread may
+  /// call this function.
+  void give_back(free_block* head, free_block* tail,
+                 size_t size_class) noexcept {
+    auto& returned = returned_[size_class];
+    auto top = returned.load(std::memory_order_relaxed);
+    do {
+      tail->next = top;
+    } while (!returned.compare_exchange_weak(top, head,
+                                             std::memory_order_release,
+                                             std::memory_order_relaxed));
+  }
+
+  /// Returns all batches to their owners.
+  void flush_all() noexcept {
+    for (size_t size_class = 0; size_class < num_size_classes; ++size_class)
+      for (auto& x : batches_[size_class])
+        flush(x, size_class);
+  }
+
+  owned_counter hits;
+  owned_counter refills;
+  owned_counter misses;
+  owned_counter remote_frees;
+  owned_counter slabs;
+
+private:
+  void* init(block_header* hdr, size_t size_class) noexcept {
+    // The link of a free block overlays the owner.
+    hdr->owner = this;
+    hdr->size_class = size_class;
+    return hdr + 1;
+  }
+
+  void* carve(size_t size_class) noexcept {
+    auto block_size = block_size_of(size_class);
+    auto& [pos, end] = slabs_[size_class];
+    if (static_cast<size_t>(end - pos) < block_size) {
+      auto slab = static_cast<std::byte*>(malloc(slab_size));
+      if (slab == nullptr)
+        return nullptr;
+      slabs.inc();
+      pos = slab;
+      end = slab + slab_size;
+    }
+    misses.inc();
+    auto hdr = reinterpret_cast<block_header*>(pos);
+    pos += block_size;
+    return init(hdr, size_class);
+  }
+
+  void flush(batch& x, size_t size_class) noexcept {
+    if (x.size > 0) {
+      x.owner->give_back(x.head, x.tail, size_class);
+      x = batch{};
+    }
+  }
+
+  /// Blocks that this thread released. Only accessed by the owner.
+  std::array<free_block*, num_size_classes> free_lists_ = {};
+
+  /// Unused range of the current slab per size class.
+  std::array<std::pair<std::byte*, std::byte*>, num_size_classes> slabs_ = {};
+
+  /// Blocks that this thread collected for other threads.
+  std::array<std::array<batch, batches_per_size_class>, num_size_classes>
+    batches_;
+
+  /// Blocks that other threads returned to this cache.
+  alignas(CAF_CACHE_LINE_SIZE)
+    std::array<std::atomic<free_block*>, num_size_classes> returned_ = {};
+};
+
+/// Keeps track of all thread caches.
+struct cache_registry {
+  std::mutex mtx;
+  std::vector<thread_cache*> all;
+  std::vector<thread_cache*> orphans;
+};
+
+cache_registry& registry() {
+  // Intentionally leaked: static destructors may still release blocks.
+  static auto* instance = new cache_registry;
+  return *instance;
+}
+
+thread_local thread_cache* local_cache_ptr = nullptr;
+
+thread_local bool local_cache_released = false;
+
+/// Assigns a cache to the current thread for the lifetime of the thread.
+struct cache_guard {
+  cache_guard() {
+    auto& reg = registry();
+    std::unique_lock guard{reg.mtx};
+    if (reg.orphans.empty()) {
+      local_cache_ptr = new thread_cache;
+      reg.all.push_back(local_cache_ptr);
+    } else {
+      local_cache_ptr = reg.orphans.back();
+      reg.orphans.pop_back();
+    }
+  }
+
+  ~cache_guard() {
+    local_cache_ptr->flush_all();
+    auto& reg = registry();
+    std::unique_lock guard{reg.mtx};
+    reg.orphans.push_back(local_cache_ptr);
+    local_cache_ptr = nullptr;
+    local_cache_released = true;
+  }
+};
+
+/// Returns the cache of the current thread or `nullptr` while the thread shuts
+/// down.
+thread_cache* local_cache() noexcept {
+  if (local_cache_ptr != nullptr)
+    return local_cache_ptr;
+  if (local_cache_released)
+    return nullptr;
+  static thread_local cache_guard guard;
+  return local_cache_ptr;
+}
+
+} // namespace
+
+void* slab_allocator::allocate(size_t size) noexcept {
+  if (enabled && size <= max_block_size)
+    if (auto cache = local_cache())
+      return cache->allocate(size_class_of(size));
+  return heap_allocate(size);
+}
+
+std::pair<void*, void*>
+slab_allocator::allocate_pair(size_t first_size, size_t second_size) noexcept {
+  auto first_offset = sizeof(pair_control) + sizeof(block_header);
+  auto second_offset = first_offset + aligned_size(first_size)
+                       + sizeof(block_header);
+  auto vptr = allocate(second_offset + second_size);
+  if (vptr == nullptr)
+    return {nullptr, nullptr};
+  auto base = static_cast<std::byte*>(vptr);
+  new (vptr) pair_control{{2}};
+  auto init = [base](size_t offset) {
+    auto hdr = reinterpret_cast<block_header*>(base + offset) - 1;
+    hdr->owner = pair_marker();
+    hdr->size_class = offset - sizeof(block_header);
+    return static_cast<void*>(hdr + 1);
+  };
+  return {init(first_offset), init(second_offset)};
+}
+
+void slab_allocator::deallocate(void* ptr) noexcept {
+  if (ptr == nullptr)
+    return;
+  auto hdr = static_cast<block_header*>(ptr) - 1;
+  auto owner = hdr->owner;
+  if (owner == pair_marker()) {
+    auto base = reinterpret_cast<std::byte*>(hdr) - hdr->size_class;
+    auto ctrl = reinterpret_cast<pair_control*>(base);
+    if (ctrl->blocks.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      ctrl->~pair_control();
+      deallocate(ctrl);
+    }
+    return;
+  }
+  if (owner == nullptr) {
+    free(hdr);
+    return;
+  }
+  auto self = local_cache();
+  if (self == owner) {
+    self->release(hdr);
+  } else if (self != nullptr) {
+    self->defer(hdr);
+  } else {
+    auto blk = reinterpret_cast<free_block*>(hdr);
+    owner->give_back(blk, blk, hdr->size_class);
+  }
+}
+
+void slab_allocator::flush() noexcept {
+  if (auto self = local_cache())
+    self->flush_all();
+}
+
+slab_allocator::statistics slab_allocator::stats() noexcept {
+  statistics result{0, 0, 0, 0, 0, 0};
+  result.heap_allocations = heap_allocations.load(std::memory_order_relaxed);
+  auto& reg = registry();
+  std::unique_lock guard{reg.mtx};
+  for (auto cache : reg.all) {
+    result.hits += cache->hits.get();
+    result.refills += cache->refills.get();
+    result.misses += cache->misses.get();
+    result.remote_frees += cache->remote_frees.get();
+    result.reserved_bytes += cache->slabs.get() * slab_size;
+  }
+  return result;
+}
+
+} // namespace caf::detail
@@ -0,0 +1,25 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/trace_buffer.hpp"
+
+#include "caf/resumable.hpp"
+#include "caf/scheduled_actor.hpp"
+
+namespace caf::detail {
+
+void trace_buffer::push_resume_begin(resumable* job) noexcept {
+  actor_id aid = 0;
+  switch (job->subtype()) {
+    case resumable::scheduled_actor:
+    case resumable::io_actor:
+      aid = static_cast<caf::scheduled_actor*>(job)->id();
+      break;
+    default:
+      break;
+  }
+  push(trace_event_type::resume_begin, aid);
+}
+
+} // namespace caf::detail
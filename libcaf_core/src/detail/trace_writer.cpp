@@ -0,0 +1,168 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/trace_writer.hpp"
+
+#include <iomanip>
+#include <string>
+#include <string_view>
+
+#include "caf/actor_system.hpp"
+#include "caf/detail/print.hpp"
+#include "caf/logger.hpp"
+#include "caf/thread_owner.hpp"
+
+namespace caf::detail {
+
+namespace {
+
+// Chrome traces expect timestamps in microseconds.
+struct micros {
+  int64_t ns;
+};
+
+std::ostream& operator<<(std::ostream& out, micros x) {
+  return out << x.ns / 1000 << '.' << std::setw(3) << std::setfill('0')
+             << x.ns % 1000;
+}
+
+// Renders `str` as quoted JSON string.
+std::string json_string(std::string_view str) {
+  std::string result;
+  print_escaped(result, str);
+  return result;
+}
+
+} // namespace
+
+trace_writer::trace_writer(std::string path, std::string process_name,
+                           size_t buffer_size, timespan interval)
+  : path_(std::move(path)),
+    process_name_(std::move(process_name)),
+    buffer_size_(buffer_size),
+    interval_(interval) {
+  // nop
+}
+
+trace_writer::~trace_writer() {
+  stop();
+}
+
+bool trace_writer::start(actor_system& sys) {
+  out_.open(path_);
+  if (!out_) {
+    CAF_LOG_WARNING("unable to open trace file" << path_);
+    return false;
+  }
+  out_ << R"({"traceEvents":[)" << '\n'
+       << R"({"name":"process_name","ph":"M","pid":1,"tid":0,)"
+       << R"("args":{"name":)" << json_string(process_name_) << "}}";
+  first_ = false;
+  thread_ = sys.launch_thread("caf.trace", thread_owner::system,
+                              [this] { run(); });
+  return true;
+}
+
+void trace_writer::stop() {
+  if (!thread_.joinable())
+    return;
+  {
+    std::unique_lock guard{mtx_};
+    stopped_ = true;
+    cv_.notify_all();
+  }
+  thread_.join();
+  std::unique_lock guard{mtx_};
+  drain();
+  out_ << "\n],\n" << R"("displayTimeUnit":"ns",)" << '\n'
+       << R"("otherData":{"droppedEvents":")" << dropped() << R"("}})"
+       << '\n';
+  out_.close();
+}
+
+trace_buffer* trace_writer::make_buffer(size_t id, std::string thread_name) {
+  std::unique_lock guard{mtx_};
+  auto& x = buffers_.emplace_back();
+  x.buf = std::make_unique<trace_buffer>(id, buffer_size_);
+  x.thread_name = std::move(thread_name);
+  return x.buf.get();
+}
+
+size_t trace_writer::dropped() const {
+  size_t result = 0;
+  for (auto& x : buffers_)
+    result += x.buf->dropped();
+  return result;
+}
+
+void trace_writer::run() {
+  std::unique_lock guard{mtx_};
+  while (!cv_.wait_for(guard, interval_, [this] { return stopped_; }))
+    drain();
+}
+
+void trace_writer::drain() {
+  for (auto& x : buffers_) {
+    if (!x.announced) {
+      begin_event();
+      out_ << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << x.buf->id()
+           << R"(,"args":{"name":)" << json_string(x.thread_name) << "}}";
+      x.announced = true;
+    }
+    x.buf->drain([this, &x](const trace_event& event) { write(event, x); });
+  }
+  out_.flush();
+}
+
+void trace_writer::begin_event() {
+  if (first_)
+    first_ = false;
+  else
+    out_ << ",\n";
+}
+
+void trace_writer::write(const trace_event& event, entry& state) {
+  auto common = [&](const char* phase) -> std::ostream& {
+    return out_ << R"("ph":")" << phase << R"(","pid":1,"tid":)"
+                << state.buf->id() << R"(,"ts":)" << micros{event.timestamp};
+  };
+  switch (event.type) {
+    case trace_event_type::resume_begin:
+      begin_event();
+      out_ << R"({"name":")";
+      if (event.value != 0)
+        out_ << "actor " << event.value;
+      else
+        out_ << "job";
+      out_ << R"(","cat":"resume",)";
+      common("B") << '}';
+      break;
+    case trace_event_type::resume_end:
+      begin_event();
+      out_ << '{';
+      common("E") << R"(,"args":{"messages":)" << state.messages << "}}";
+      state.messages = 0;
+      break;
+    case trace_event_type::messages:
+      state.messages += event.value;
+      break;
+    case trace_event_type::steal:
+      begin_event();
+      out_ << R"({"name":"steal","cat":"scheduler","s":"t",)";
+      common("i") << R"(,"args":{"jobs":)" << event.value << "}}";
+      break;
+    case trace_event_type::park:
+      begin_event();
+      out_ << R"({"name":"park","cat":"scheduler",)";
+      common("B") << '}';
+      break;
+    case trace_event_type::unpark:
+      begin_event();
+      out_ << '{';
+      common("E") << '}';
+      break;
+  }
+}
+
+} // namespace caf::detail
@@ -0,0 +1,49 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/worker_activity.hpp"
+
+#include "caf/resumable.hpp"
+#include "caf/scheduled_actor.hpp"
+
+namespace caf::detail {
+
+void worker_activity::begin(resumable* job) noexcept {
+  // Note: the watchdog reads the slot after the job may have finished. Hence,
+  //       the slot must not store anything that points into the job, such as
+  //       the name of an actor.
+  actor_id aid = 0;
+  switch (job->subtype()) {
+    case resumable::scheduled_actor:
+    case resumable::io_actor: {
+      aid = static_cast<caf::scheduled_actor*>(job)->id();
+      break;
+    }
+    default:
+      break;
+  }
+  // Seqlock protocol: the sequence number is odd while writing.
+  auto seq = seq_.load(std::memory_order_relaxed);
+  seq_.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  aid_.store(aid, std::memory_order_relaxed);
+  since_.store(now(), std::memory_order_relaxed);
+  seq_.store(seq + 2, std::memory_order_release);
+}
+
+worker_activity::snapshot worker_activity::read() const noexcept {
+  snapshot result{0, 0, 0};
+  auto seq = seq_.load(std::memory_order_acquire);
+  if (seq % 2 != 0)
+    return result;
+  result.seq = seq;
+  result.since = since_.load(std::memory_order_relaxed);
+  result.aid = aid_.load(std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (seq_.load(std::memory_order_relaxed) != seq)
+    result.since = 0;
+  return result;
+}
+
+} // namespace caf::detail
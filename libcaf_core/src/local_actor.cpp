@@ -17,6 +17,7 @@
 #include "caf/disposable.hpp"
 #include "caf/exit_reason.hpp"
 #include "caf/logger.hpp"
+#include "caf/mailbox_element.hpp"
 #include "caf/resumable.hpp"
 #include "caf/scheduler.hpp"
 #include "caf/sec.hpp"
@@ -36,21 +37,44 @@ local_actor::metrics_t make_instance_metrics(local_actor* self) {
   if (includes.empty()
       || std::none_of(includes.begin(), includes.end(), matches)
       || std::any_of(excludes.begin(), excludes.end(), matches))
-    return {
-      nullptr,
-      nullptr,
-      nullptr,
-    };
+    return {nullptr, nullptr, nullptr, nullptr, 1};
   self->setf(abstract_actor::collects_metrics_flag);
+  // The longest matching pattern selects the sample rate.
+  size_t sample_rate = 1;
+  size_t pattern_size = 0;
+  for (auto& [glob, rate] : sys.metrics_actors_sample_rates()) {
+    if (glob.size() >= pattern_size && matches(glob)) {
+      sample_rate = rate;
+      pattern_size = glob.size();
+    }
+  }
   const auto& families = sys.actor_metric_families();
   std::string_view sv{name, strlen(name)};
   return {
     families.processing_time->get_or_add({{"name", sv}}),
     families.mailbox_time->get_or_add({{"name", sv}}),
     families.mailbox_size->get_or_add({{"name", sv}}),
+    families.pending_requests->get_or_add({{"name", sv}}),
+    sample_rate,
   };
 }
 
+/// State of the pseudo-random number generator for sampling messages. Each
+/// thread draws its own numbers to avoid any synchronization on the sender
+/// side.
+thread_local uint64_t sample_state = 0x9E3779B97F4A7C15;
+
+/// Returns `true` with a probability of `1 / rate`.
+bool draw_sample(size_t rate) noexcept {
+  // Marsaglia's xorshift64.
+  auto x = sample_state;
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  sample_state = x;
+  return x % rate == 0;
+}
+
 } // namespace
 
 local_actor::local_actor(actor_config& cfg)
@@ -58,13 +82,31 @@ local_actor::local_actor(actor_config& cfg)
     context_(cfg.host),
     current_element_(nullptr),
     initial_behavior_fac_(std::move(cfg.init_fun)) {
-  // nop
+  if (cfg.mailbox_capacity > 0)
+    mailbox_bound_ = std::make_unique<detail::mailbox_bound>(
+      cfg.mailbox_capacity, cfg.mailbox_overflow);
 }
 
 local_actor::~local_actor() {
   // nop
 }
 
+void local_actor::sample_enqueue_time(mailbox_element& x) noexcept {
+  if (metrics_.sample_rate <= 1 || draw_sample(metrics_.sample_rate))
+    x.set_enqueue_time();
+  else
+    x.clear_enqueue_time();
+}
+
+void local_actor::track_queued_messages() {
+  tracks_queued_messages_.store(true, std::memory_order_relaxed);
+}
+
+size_t local_actor::queued_messages() const noexcept {
+  auto n = queued_messages_.load(std::memory_order_relaxed);
+  return n > 0 ? static_cast<size_t>(n) : 0;
+}
+
 void local_actor::on_destroy() {
   CAF_PUSH_AID_FROM_PTR(this);
 #ifdef CAF_ENABLE_ACTOR_PROFILER
@@ -77,6 +119,46 @@ void local_actor::on_destroy() {
   }
 }
 
+bool local_actor::reserve_mailbox_slot(const mailbox_element& x) {
+  auto& bound = *mailbox_bound_;
+  if (x.mid.is_response() || x.mid.is_urgent_message()) {
+    bound.force_reserve();
+    return true;
+  }
+  switch (bound.policy()) {
+    case mailbox_overflow_policy::drop_oldest:
+      bound.force_reserve();
+      return true;
+    case mailbox_overflow_policy::block:
+      if (x.sender && x.sender->get() != this
+          && x.sender->get()->getf(is_blocking_flag)) {
+        // After closing the mailbox, the caller fails to enqueue the message
+        // and releases the slot again.
+        if (!bound.reserve_or_wait())
+          bound.force_reserve();
+        return true;
+      }
+      break;
+    default:
+      break;
+  }
+  if (bound.try_reserve())
+    return true;
+  CAF_LOG_DEBUG("mailbox full, drop message:" << CAF_ARG(x));
+  count_dropped_messages();
+  // Note: we cannot use the sync_request_bouncer here, since it always
+  //       responds with request_receiver_down.
+  if (x.sender && x.mid.is_request()
+      && bound.policy() != mailbox_overflow_policy::drop_newest)
+    x.sender->enqueue(nullptr, x.mid.response_id(),
+                      make_message(make_error(sec::mailbox_full)), nullptr);
+  return false;
+}
+
+void local_actor::count_dropped_messages(size_t n) {
+  home_system().base_metrics().dropped_messages->inc(static_cast<int64_t>(n));
+}
+
 void local_actor::setup_metrics() {
   metrics_ = make_instance_metrics(this);
 }
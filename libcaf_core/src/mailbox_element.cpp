@@ -5,6 +5,10 @@
 #include "caf/mailbox_element.hpp"
 
 #include <memory>
+#include <new>
+
+#include "caf/detail/slab_allocator.hpp"
+#include "caf/raise_error.hpp"
 
 namespace caf {
 
@@ -17,6 +21,17 @@ mailbox_element::mailbox_element(strong_actor_ptr sender, message_id mid,
   // nop
 }
 
+void* mailbox_element::operator new(size_t size) {
+  auto result = detail::slab_allocator::allocate(size);
+  if (result == nullptr)
+    CAF_RAISE_ERROR(std::bad_alloc, "bad_alloc");
+  return result;
+}
+
+void mailbox_element::operator delete(void* ptr) noexcept {
+  detail::slab_allocator::deallocate(ptr);
+}
+
 mailbox_element_ptr
 make_mailbox_element(strong_actor_ptr sender, message_id id,
                      mailbox_element::forwarding_stack stages,
@@ -4,6 +4,8 @@
 
 #include "caf/monitorable_actor.hpp"
 
+#include <iterator>
+
 #include "caf/actor_cast.hpp"
 #include "caf/actor_system.hpp"
 #include "caf/default_attachable.hpp"
@@ -64,12 +66,14 @@ void monitorable_actor::unlink_from(const actor_addr& x) {
 bool monitorable_actor::cleanup(error&& reason, execution_unit* host) {
   CAF_LOG_TRACE(CAF_ARG(reason));
   attachable_ptr head;
+  observer_map observers;
   bool set_fail_state = exclusive_critical_section([&]() -> bool {
     if (!getf(is_cleaned_up_flag)) {
       // local actors pass fail_state_ as first argument
       if (&fail_state_ != &reason)
         fail_state_ = std::move(reason);
       attachables_head_.swap(head);
+      observers_.swap(observers);
       flags(flags() | is_terminated_flag | is_cleaned_up_flag);
       on_cleanup(fail_state_);
       return true;
@@ -83,6 +87,8 @@ bool monitorable_actor::cleanup(error&& reason, execution_unit* host) {
   // send exit messages
   for (attachable* i = head.get(); i != nullptr; i = i->next.get())
     i->actor_exited(fail_state_, host);
+  if (!observers.empty())
+    notify_observers(observers, host);
   // tell printer to purge its state for us if we ever used aout()
   if (getf(abstract_actor::has_used_aout_flag)) {
     auto pr = home_system().scheduler().printer();
@@ -93,6 +99,24 @@ bool monitorable_actor::cleanup(error&& reason, execution_unit* host) {
   return true;
 }
 
+void monitorable_actor::notify_observers(observer_map& observers,
+                                         execution_unit* host) {
+  // All observers share the same content, which saves us from creating one
+  // message per observer while the actor shuts down. Links go first to
+  // propagate errors as early as possible.
+  auto sender = actor_cast<strong_actor_ptr>(address());
+  auto notify_all = [&](default_attachable::observe_type type,
+                        const message& msg) {
+    for (auto& [key, ptr] : observers)
+      if (key.type == type)
+        static_cast<default_attachable&>(*ptr).notify(sender, msg, host);
+  };
+  notify_all(default_attachable::link,
+             make_message(exit_msg{address(), fail_state_}));
+  notify_all(default_attachable::monitor,
+             make_message(down_msg{address(), fail_state_}));
+}
+
 void monitorable_actor::on_cleanup(const error&) {
   // nop
 }
@@ -178,9 +202,36 @@ error monitorable_actor::fail_state() const {
   return fail_state_;
 }
 
+void monitorable_actor::attach_impl(attachable_ptr& ptr) {
+  if (ptr->token_type() == attachable::token::observer) {
+    auto& x = static_cast<default_attachable&>(*ptr);
+    observer_key key{x.observer(), x.type()};
+    observers_.emplace(std::move(key), std::move(ptr));
+    return;
+  }
+  ptr->next.swap(attachables_head_);
+  attachables_head_.swap(ptr);
+}
+
 size_t monitorable_actor::detach_impl(const attachable::token& what,
                                       bool stop_on_hit, bool dry_run) {
   CAF_LOG_TRACE(CAF_ARG(stop_on_hit) << CAF_ARG(dry_run));
+  if (what.subtype == attachable::token::observer) {
+    using token_type = default_attachable::observe_token;
+    auto& tk = *reinterpret_cast<const token_type*>(what.ptr);
+    auto [first, last] = observers_.equal_range({tk.observer, tk.type});
+    if (first == last)
+      return 0;
+    if (stop_on_hit) {
+      if (!dry_run)
+        observers_.erase(first);
+      return 1;
+    }
+    auto count = static_cast<size_t>(std::distance(first, last));
+    if (!dry_run)
+      observers_.erase(first, last);
+    return count;
+  }
   size_t count = 0;
   auto i = &attachables_head_;
   while (*i != nullptr) {
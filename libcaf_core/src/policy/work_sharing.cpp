@@ -4,8 +4,59 @@
 
 #include "caf/policy/work_sharing.hpp"
 
+#include <algorithm>
+
+#include "caf/actor_system_config.hpp"
+#include "caf/config_value.hpp"
+#include "caf/scheduler/abstract_coordinator.hpp"
+
 namespace caf::policy {
 
+namespace {
+
+constexpr size_t min_shard_capacity = 64;
+
+} // namespace
+
+void work_sharing::shard::push(resumable* job) {
+  std::unique_lock guard{lock_};
+  auto n = size_.load(std::memory_order_relaxed);
+  if (n == buf_.size()) {
+    // Grow the ring buffer and move all jobs to the front.
+    std::vector<resumable*> tmp;
+    tmp.reserve(std::max(buf_.size() * 2, min_shard_capacity));
+    for (size_t i = 0; i < n; ++i)
+      tmp.push_back(buf_[(head_ + i) % buf_.size()]);
+    tmp.resize(tmp.capacity());
+    buf_.swap(tmp);
+    head_ = 0;
+  }
+  buf_[(head_ + n) % buf_.size()] = job;
+  size_.store(n + 1, std::memory_order_relaxed);
+}
+
+resumable* work_sharing::shard::try_pop() {
+  std::unique_lock guard{lock_};
+  auto n = size_.load(std::memory_order_relaxed);
+  if (n == 0)
+    return nullptr;
+  auto result = buf_[head_];
+  head_ = (head_ + 1) % buf_.size();
+  size_.store(n - 1, std::memory_order_relaxed);
+  return result;
+}
+
+work_sharing::coordinator_data::coordinator_data(
+  scheduler::abstract_coordinator* p)
+  : next_shard(0) {
+  // Note: the coordinator calls our constructor before initializing itself.
+  //       Hence, we cannot use p->num_workers() here.
+  auto num_shards = p->configured_num_workers();
+  queue.reserve(num_shards);
+  for (size_t i = 0; i < num_shards; ++i)
+    queue.emplace_back(std::make_unique<shard>());
+}
+
 work_sharing::~work_sharing() {
   // nop
 }
@@ -8,6 +8,7 @@
 #include "caf/config_value.hpp"
 #include "caf/defaults.hpp"
 #include "caf/scheduler/abstract_coordinator.hpp"
+#include "caf/telemetry/metric_registry.hpp"
 
 #define CONFIG(str_name, var_name)                                             \
   get_or(p->config(), "caf.work-stealing." str_name,                           \
@@ -15,6 +16,25 @@
 
 namespace caf::policy {
 
+namespace {
+
+auto make_victim_table(const detail::cpu_topology& topology,
+                       size_t num_workers) {
+  auto result = std::make_shared<work_stealing::victim_table>(num_workers);
+  for (size_t thief = 0; thief < num_workers; ++thief) {
+    auto& tiers = (*result)[thief];
+    for (size_t victim = 0; victim < num_workers; ++victim) {
+      if (victim == thief)
+        continue;
+      auto tier = topology.worker_locality(thief, victim);
+      tiers[static_cast<size_t>(tier)].emplace_back(victim);
+    }
+  }
+  return result;
+}
+
+} // namespace
+
 work_stealing::~work_stealing() {
   // nop
 }
@@ -27,19 +47,34 @@ work_stealing::worker_data::worker_data(scheduler::abstract_coordinator* p)
     strategies{
       {{CONFIG("aggressive-poll-attempts", aggressive_poll_attempts), 1,
         CONFIG("aggressive-steal-interval", aggressive_steal_interval),
-        timespan{0}},
+        timespan{0},
+        CONFIG("aggressive-steal-batch-size", aggressive_steal_batch_size)},
        {CONFIG("moderate-poll-attempts", moderate_poll_attempts), 1,
         CONFIG("moderate-steal-interval", moderate_steal_interval),
-        CONFIG("moderate-sleep-duration", moderate_sleep_duration)},
-       {1, 0, CONFIG("relaxed-steal-interval", relaxed_steal_interval),
-        CONFIG("relaxed-sleep-duration", relaxed_sleep_duration)}}} {
-  // nop
+        CONFIG("moderate-sleep-duration", moderate_sleep_duration),
+        CONFIG("moderate-steal-batch-size", moderate_steal_batch_size)}}},
+    steals{},
+    max_next_streak(CONFIG("max-next-slot-runs", max_next_slot_runs)) {
+  if (auto& topology = p->topology(); !topology.empty()) {
+    victims = make_victim_table(topology, p->num_workers());
+    auto& reg = p->system().metrics();
+    for (size_t tier = 0; tier < steals.size(); ++tier) {
+      auto lbl = to_label(static_cast<detail::cpu_locality>(tier));
+      steals[tier] = reg.counter_instance(
+        "caf.scheduler", "steals",
+        {{"pool", p->pool_name()}, {"locality", lbl}},
+        "Number of jobs stolen from other workers.", "1", true);
+    }
+  }
 }
 
 work_stealing::worker_data::worker_data(const worker_data& other)
   : rengine(std::random_device{}()),
     uniform(other.uniform),
-    strategies(other.strategies) {
+    strategies(other.strategies),
+    victims(other.victims),
+    steals(other.steals),
+    max_next_streak(other.max_next_streak) {
   // nop
 }
 
@@ -4,6 +4,9 @@
 
 #include "caf/scheduled_actor.hpp"
 
+#include <algorithm>
+#include <chrono>
+
 #include "caf/action.hpp"
 #include "caf/actor_ostream.hpp"
 #include "caf/actor_system_config.hpp"
@@ -13,6 +16,7 @@
 #include "caf/detail/meta_object.hpp"
 #include "caf/detail/private_thread.hpp"
 #include "caf/detail/sync_request_bouncer.hpp"
+#include "caf/detail/trace_buffer.hpp"
 #include "caf/flow/observable.hpp"
 #include "caf/flow/observable_builder.hpp"
 #include "caf/flow/op/mcast.hpp"
@@ -124,7 +128,9 @@ scheduled_actor::scheduled_actor(actor_config& cfg)
     down_handler_(default_down_handler),
     node_down_handler_(default_node_down_handler),
     exit_handler_(default_exit_handler),
-    private_thread_(nullptr)
+    private_thread_(nullptr),
+    pool_(cfg.pool),
+    drr_quantum_(0)
 #ifdef CAF_ENABLE_EXCEPTIONS
     ,
     exception_handler_(default_exception_handler)
@@ -146,9 +152,12 @@ bool scheduled_actor::enqueue(mailbox_element_ptr ptr, execution_unit* eu) {
   CAF_LOG_SEND_EVENT(ptr);
   auto mid = ptr->mid;
   auto sender = ptr->sender;
+  if (mailbox_bound_ && !reserve_mailbox_slot(*ptr))
+    return false;
+  count_queued_messages();
   auto collects_metrics = getf(abstract_actor::collects_metrics_flag);
   if (collects_metrics) {
-    ptr->set_enqueue_time();
+    sample_enqueue_time(*ptr);
     metrics_.mailbox_size->inc();
   }
   switch (mailbox().push_back(std::move(ptr))) {
@@ -157,10 +166,8 @@ bool scheduled_actor::enqueue(mailbox_element_ptr ptr, execution_unit* eu) {
       intrusive_ptr_add_ref(ctrl());
       if (private_thread_)
         private_thread_->resume(this);
-      else if (eu != nullptr)
-        eu->exec_later(this);
       else
-        home_system().scheduler().enqueue(this);
+        schedule(eu);
       return true;
     }
     case intrusive::inbox_result::success:
@@ -170,6 +177,7 @@ bool scheduled_actor::enqueue(mailbox_element_ptr ptr, execution_unit* eu) {
     default: { // intrusive::inbox_result::queue_closed
       CAF_LOG_REJECT_EVENT();
       home_system().base_metrics().rejected_messages->inc();
+      release_mailbox_slots();
       if (collects_metrics)
         metrics_.mailbox_size->dec();
       if (mid.is_request()) {
@@ -181,13 +189,67 @@ bool scheduled_actor::enqueue(mailbox_element_ptr ptr, execution_unit* eu) {
   }
 }
 
+bool scheduled_actor::enqueue_batch(mailbox_element_ptr first,
+                                    execution_unit* eu) {
+  CAF_ASSERT(first != nullptr);
+  CAF_ASSERT(!getf(is_blocking_flag));
+  // Bounded mailboxes decide for each message whether to accept it.
+  if (mailbox_bound_)
+    return super::enqueue_batch(std::move(first), eu);
+  auto collects_metrics = getf(abstract_actor::collects_metrics_flag);
+  size_t n = 0;
+  for (auto ptr = first.get(); ptr != nullptr;
+       ptr = static_cast<mailbox_element*>(ptr->next)) {
+    CAF_LOG_SEND_EVENT(ptr);
+    if (collects_metrics)
+      sample_enqueue_time(*ptr);
+    ++n;
+  }
+  if (collects_metrics)
+    metrics_.mailbox_size->inc(static_cast<int64_t>(n));
+  count_queued_messages(n);
+  switch (mailbox().push_back_chain(first.get())) {
+    case intrusive::inbox_result::unblocked_reader: {
+      CAF_LOG_ACCEPT_EVENT(true);
+      first.release();
+      intrusive_ptr_add_ref(ctrl());
+      if (private_thread_)
+        private_thread_->resume(this);
+      else
+        schedule(eu);
+      return true;
+    }
+    case intrusive::inbox_result::success:
+      CAF_LOG_ACCEPT_EVENT(false);
+      first.release();
+      return true;
+    default: { // intrusive::inbox_result::queue_closed
+      CAF_LOG_REJECT_EVENT();
+      auto signed_n = static_cast<int64_t>(n);
+      home_system().base_metrics().rejected_messages->inc(signed_n);
+      if (collects_metrics)
+        metrics_.mailbox_size->dec(signed_n);
+      release_mailbox_slots(n);
+      detail::sync_request_bouncer f{exit_reason()};
+      while (first != nullptr) {
+        mailbox_element_ptr next{static_cast<mailbox_element*>(first->next)};
+        first->next = nullptr;
+        if (first->mid.is_request())
+          f(first->sender, first->mid);
+        first = std::move(next);
+      }
+      return false;
+    }
+  }
+}
+
 mailbox_element* scheduled_actor::peek_at_next_mailbox_element() {
   if (mailbox().closed() || mailbox().blocked()) {
     return nullptr;
   } else if (awaited_responses_.empty()) {
     return mailbox().peek();
   } else {
-    auto mid = awaited_responses_.begin()->first;
+    auto mid = awaited_responses_.back().first;
     auto pred = [mid](mailbox_element& x) { return x.mid == mid; };
     return mailbox().find_if(pred);
   }
@@ -215,7 +277,7 @@ void scheduled_actor::launch(execution_unit* ctx, bool lazy, bool hide) {
     }
   } else if (!delay_first_scheduling) {
     intrusive_ptr_add_ref(ctrl());
-    ctx->exec_later(this);
+    schedule(ctx);
   }
 }
 
@@ -226,8 +288,9 @@ bool scheduled_actor::cleanup(error&& fail_state, execution_unit* host) {
   if (private_thread_)
     home_system().release_private_thread(private_thread_);
   // Clear state for open requests.
-  awaited_responses_.clear();
-  multiplexed_responses_.clear();
+  clear_response_handlers();
+  pending_request_timeout_.dispose();
+  request_timeouts_.clear();
   // Cancel any active flow.
   while (!watched_disposables_.empty()) {
     CAF_LOG_DEBUG("clean up" << watched_disposables_.size()
@@ -238,8 +301,12 @@ bool scheduled_actor::cleanup(error&& fail_state, execution_unit* host) {
     run_actions();
   }
   // Clear mailbox.
+  if (conflation_)
+    conflation_->clear();
   if (!mailbox_.closed()) {
     mailbox_.close();
+    if (mailbox_bound_)
+      mailbox_bound_->close();
     get_normal_queue().flush_cache();
     get_urgent_queue().flush_cache();
     detail::sync_request_bouncer bounce{fail_state};
@@ -276,45 +343,81 @@ resumable::resume_result scheduled_actor::resume(execution_unit* ctx,
   CAF_LOG_TRACE(CAF_ARG(max_throughput));
   if (!activate(ctx))
     return resumable::done;
+  auto& sched = home_system().scheduler();
+  if (drr_quantum_ == 0)
+    drr_quantum_ = sched.drr_quantum();
   size_t consumed = 0;
+  // Reading the clock after each message would add noticeable overhead for
+  // actors with cheap handlers. Hence, we only check whether the actor ran out
+  // of time after every `time_check_interval` messages.
+  static constexpr size_t time_check_interval = 4;
+  using clock_type = std::chrono::steady_clock;
+  auto max_run_time = sched.max_run_time();
+  auto deadline = clock_type::time_point{};
+  if (max_run_time.count() > 0)
+    deadline = clock_type::now() + max_run_time;
+  auto out_of_time = false;
   auto reset_timeouts_if_needed = [&] {
     // Set a new receive timeout if we called our behavior at least once.
     if (consumed > 0)
       set_receive_timeout();
   };
+  // Checks whether the actor must yield after consuming a message.
+  auto must_yield = [&] {
+    if (++consumed >= max_throughput)
+      return true;
+    if (deadline != clock_type::time_point{}
+        && consumed % time_check_interval == 0
+        && clock_type::now() >= deadline) {
+      out_of_time = true;
+      return true;
+    }
+    return false;
+  };
   // Callback for handling urgent and normal messages.
-  auto handle_async = [this, max_throughput, &consumed](mailbox_element& x) {
-    return run_with_metrics(x, [this, max_throughput, &consumed, &x] {
+  auto handle_async = [this, &must_yield](mailbox_element& x) {
+    // The handler may move the content out of `x`, so we forget `x` first.
+    if (conflation_)
+      conflation_->erase(x);
+    auto result = run_with_metrics(x, [this, &must_yield, &x] {
       switch (reactivate(x)) {
         case activation_result::terminated:
           return intrusive::task_result::stop;
         case activation_result::success:
-          return ++consumed < max_throughput ? intrusive::task_result::resume
-                                             : intrusive::task_result::stop_all;
+          return must_yield() ? intrusive::task_result::stop_all
+                              : intrusive::task_result::resume;
         case activation_result::skipped:
           return intrusive::task_result::skip;
         default:
           return intrusive::task_result::resume;
       }
     });
+    if (result != intrusive::task_result::skip)
+      release_mailbox_slots();
+    return result;
   };
   mailbox_element_ptr ptr;
-  while (consumed < max_throughput) {
+  while (consumed < max_throughput && !out_of_time) {
     CAF_LOG_DEBUG("start new DRR round");
-    mailbox_.fetch_more();
+    if (conflation_)
+      fetch_and_conflate();
+    else
+      mailbox_.fetch_more();
+    if (mailbox_bound_)
+      drop_oldest_messages();
     auto prev = consumed; // Caches the value before processing more.
-    // TODO: maybe replace '3' with configurable / adaptive value?
-    static constexpr size_t quantum = 3;
     // Dispatch urgent and normal (asynchronous) messages.
     auto& hq = get_urgent_queue();
     auto& nq = get_normal_queue();
-    if (hq.new_round(quantum * 3, handle_async).consumed_items > 0) {
+    auto& hf = urgent_cache_filter_;
+    auto& nf = normal_cache_filter_;
+    if (hq.new_round(drr_quantum_ * 3, handle_async, hf).consumed_items > 0) {
       // After matching any message, all caches must be re-evaluated.
-      nq.flush_cache();
+      nq.flush_cache_if(nf);
     }
-    if (nq.new_round(quantum, handle_async).consumed_items > 0) {
+    if (nq.new_round(drr_quantum_, handle_async, nf).consumed_items > 0) {
       // After matching any message, all caches must be re-evaluated.
-      hq.flush_cache();
+      hq.flush_cache_if(hf);
     }
     // Update metrics or try returning if the actor consumed nothing.
     auto delta = consumed - prev;
@@ -322,8 +425,15 @@ resumable::resume_result scheduled_actor::resume(execution_unit* ctx,
     if (delta > 0) {
       auto signed_val = static_cast<int64_t>(delta);
       home_system().base_metrics().processed_messages->inc(signed_val);
+      if (auto buf = ctx != nullptr ? ctx->trace_buffer() : nullptr)
+        buf->push(detail::trace_event_type::messages, delta);
+      // Consume more messages per round while the actor has a backlog in
+      // order to amortize the cost of each round.
+      if (!nq.empty())
+        drr_quantum_ = std::min(drr_quantum_ * 2, sched.max_drr_quantum());
     } else {
       reset_timeouts_if_needed();
+      drr_quantum_ = sched.drr_quantum();
       if (mailbox().try_block())
         return resumable::awaiting_message;
       CAF_LOG_DEBUG("mailbox().try_block() returned false");
@@ -332,14 +442,32 @@ resumable::resume_result scheduled_actor::resume(execution_unit* ctx,
     if (finalize())
       return resumable::done;
   }
-  CAF_LOG_DEBUG("max throughput reached");
+  CAF_LOG_DEBUG("max throughput or max run time reached");
   reset_timeouts_if_needed();
-  if (mailbox().try_block())
+  if (mailbox().try_block()) {
+    drr_quantum_ = sched.drr_quantum();
     return resumable::awaiting_message;
+  }
   // time's up
+  auto& metrics = home_system().base_metrics();
+  if (out_of_time)
+    metrics.max_run_time_yields->inc();
+  else
+    metrics.max_throughput_yields->inc();
   return resumable::resume_later;
 }
 
+void scheduled_actor::schedule(execution_unit* ctx) {
+  // Only workers of our own pool may run this actor. Any other execution unit
+  // must hand the actor over to our scheduler.
+  if (ctx != nullptr && ctx->pool() == pool_)
+    ctx->exec_later(this);
+  else if (pool_ != nullptr)
+    pool_->enqueue(this);
+  else
+    home_system().scheduler().enqueue(this);
+}
+
 // -- scheduler callbacks ------------------------------------------------------
 
 proxy_registry* scheduled_actor::proxy_registry_ptr() {
@@ -361,8 +489,7 @@ void scheduled_actor::quit(error x) {
   fail_state_ = std::move(x);
   // Clear state for handling regular messages.
   bhvr_stack_.clear();
-  awaited_responses_.clear();
-  multiplexed_responses_.clear();
+  clear_response_handlers();
   // Ignore future exit, down and error messages.
   set_exit_handler(silently_ignore<exit_msg>);
   set_down_handler(silently_ignore<down_msg>);
@@ -520,7 +647,9 @@ void scheduled_actor::add_awaited_response_handler(message_id response_id,
                                                    behavior bhvr) {
   if (bhvr.timeout() != infinite)
     request_response_timeout(bhvr.timeout(), response_id);
-  awaited_responses_.emplace_front(response_id, std::move(bhvr));
+  awaited_responses_.emplace_back(response_id, std::move(bhvr));
+  if (getf(abstract_actor::collects_metrics_flag))
+    metrics_.pending_requests->inc();
 }
 
 void scheduled_actor::add_multiplexed_response_handler(message_id response_id,
@@ -528,6 +657,8 @@ void scheduled_actor::add_multiplexed_response_handler(message_id response_id,
   if (bhvr.timeout() != infinite)
     request_response_timeout(bhvr.timeout(), response_id);
   multiplexed_responses_.emplace(response_id, std::move(bhvr));
+  if (getf(abstract_actor::collects_metrics_flag))
+    metrics_.pending_requests->inc();
 }
 
 scheduled_actor::message_category
@@ -694,21 +825,35 @@ invoke_message_result scheduled_actor::consume(mailbox_element& x) {
       return f(in.content()) != std::nullopt;
     };
     auto select_invoke_fun = [&]() -> fun_t { return ordinary_invoke; };
+    // Check for expired request timeouts. We need to do this before looking
+    // at awaited responses, since the timeout may belong to one of them.
+    if (x.mid.is_response() && x.mid == request_timeout_tick_) {
+      expire_request_timeouts();
+      return invoke_message_result::consumed;
+    }
     // Short-circuit awaited responses.
     if (!awaited_responses_.empty()) {
       auto invoke = select_invoke_fun();
-      auto& pr = awaited_responses_.front();
+      auto& pr = awaited_responses_.back();
       // skip all messages until we receive the currently awaited response
-      if (x.mid != pr.first)
+      if (x.mid != pr.first) {
+        // The skipped message may have any type.
+        normal_cache_filter_.mark_dirty();
+        urgent_cache_filter_.mark_dirty();
         return invoke_message_result::skipped;
+      }
       auto f = std::move(pr.second);
-      awaited_responses_.pop_front();
+      awaited_responses_.pop_back();
+      if (getf(abstract_actor::collects_metrics_flag))
+        metrics_.pending_requests->dec();
       if (!invoke(this, f, x)) {
         // try again with error if first attempt failed
         auto msg = make_message(
           make_error(sec::unexpected_response, std::move(x.payload)));
         f(msg);
       }
+      if (!expired_awaited_responses_.empty())
+        expire_awaited_responses();
       return invoke_message_result::consumed;
     }
     // Handle multiplexed responses.
@@ -720,6 +865,8 @@ invoke_message_result scheduled_actor::consume(mailbox_element& x) {
         return invoke_message_result::dropped;
       auto bhvr = std::move(mrh->second);
       multiplexed_responses_.erase(mrh);
+      if (getf(abstract_actor::collects_metrics_flag))
+        metrics_.pending_requests->dec();
       if (!invoke(this, bhvr, x)) {
         CAF_LOG_DEBUG("got unexpected_response");
         auto msg = make_message(
@@ -895,7 +1042,7 @@ void scheduled_actor::push_to_cache(mailbox_element_ptr ptr) {
   auto& qs = mailbox_.queue().queues();
   auto push = [&ptr](auto& q) {
     q.inc_total_task_size(q.policy().task_size(*ptr));
-    q.cache().push_back(ptr.release());
+    q.push_to_cache(ptr.release());
   };
   if (p.id_of(*ptr) == normal_queue_index)
     push(std::get<normal_queue_index>(qs));
@@ -911,6 +1058,64 @@ scheduled_actor::normal_queue& scheduled_actor::get_normal_queue() {
   return get<normal_queue_index>(mailbox_.queue().queues());
 }
 
+void scheduled_actor::drop_oldest_messages() {
+  // Responses and urgent messages may exceed the capacity with any policy.
+  // Only drop_oldest makes room for them by dropping ordinary messages.
+  if (mailbox_bound_->policy() != mailbox_overflow_policy::drop_oldest)
+    return;
+  auto& nq = get_normal_queue();
+  size_t dropped = 0;
+  for (auto n = mailbox_bound_->excess(); n > 0; --n) {
+    auto ptr = nq.take_front();
+    if (!ptr)
+      break;
+    if (conflation_)
+      conflation_->erase(*ptr);
+    CAF_LOG_DEBUG("mailbox full, drop message:" << CAF_ARG(*ptr));
+    ++dropped;
+  }
+  if (dropped > 0) {
+    count_dropped_messages(dropped);
+    release_mailbox_slots(dropped);
+    if (getf(abstract_actor::collects_metrics_flag))
+      metrics_.mailbox_size->dec(static_cast<int64_t>(dropped));
+  }
+}
+
+void scheduled_actor::fetch_and_conflate() {
+  auto& items = get_normal_queue().items();
+  auto pos = items.empty() ? nullptr : items.back();
+  if (!mailbox_.fetch_more())
+    return;
+  // Only the messages after `pos` are new.
+  auto conflated = items.erase_after_if(pos, [this](mailbox_element& x) {
+    return conflation_->conflate(x);
+  });
+  if (conflated > 0) {
+    CAF_LOG_DEBUG("conflated" << conflated << "messages");
+    home_system().base_metrics().conflated_messages->inc(
+      static_cast<int64_t>(conflated));
+    release_mailbox_slots(conflated);
+    if (getf(abstract_actor::collects_metrics_flag))
+      metrics_.mailbox_size->dec(static_cast<int64_t>(conflated));
+  }
+}
+
+bool scheduled_actor::cache_filter::retry_all() noexcept {
+  // Messages that the actor skipped while awaiting a response may have any
+  // type. Hence, we retry all messages until the actor stops waiting.
+  if (!self_->skips_unexpected_messages_
+      || !self_->awaited_responses_.empty())
+    return true;
+  return std::exchange(dirty_, false);
+}
+
+bool scheduled_actor::cache_filter::retry(
+  type_id_list types) const noexcept {
+  auto& stack = self_->bhvr_stack_;
+  return !stack.empty() && stack.back().accepts(types);
+}
+
 disposable scheduled_actor::run_scheduled(timestamp when, action what) {
   CAF_ASSERT(what.ptr() != nullptr);
   CAF_LOG_TRACE(CAF_ARG(when));
@@ -949,6 +1154,114 @@ disposable scheduled_actor::run_delayed_weak(timespan delay, action what) {
   return run_scheduled_weak(clock().now() + delay, std::move(what));
 }
 
+namespace {
+
+// Turns `std::push_heap` and friends into a min-heap for request deadlines.
+constexpr auto later_deadline = [](const auto& x, const auto& y) {
+  return x.first > y.first;
+};
+
+} // namespace
+
+disposable scheduled_actor::request_response_timeout(timespan timeout,
+                                                     message_id mid) {
+  CAF_LOG_TRACE(CAF_ARG(timeout) << CAF_ARG(mid));
+  if (timeout == infinite)
+    return {};
+  auto t = clock().now() + timeout;
+  request_timeouts_.emplace_back(t, mid.response_id());
+  std::push_heap(request_timeouts_.begin(), request_timeouts_.end(),
+                 later_deadline);
+  if (!request_timeout_tick_.is_response() || t < next_request_timeout_)
+    schedule_request_timeout_tick(t);
+  return {};
+}
+
+void scheduled_actor::schedule_request_timeout_tick(
+  actor_clock::time_point when) {
+  CAF_LOG_TRACE(CAF_ARG(when));
+  pending_request_timeout_.dispose();
+  // A fresh ID per tick makes sure that we ignore a canceled tick if the clock
+  // has enqueued it already.
+  request_timeout_tick_ = new_request_id(message_priority::normal)
+                            .response_id();
+  next_request_timeout_ = when;
+  pending_request_timeout_ = clock().schedule_message(
+    when, strong_actor_ptr{ctrl()},
+    make_mailbox_element(nullptr, request_timeout_tick_, {}, make_message()));
+}
+
+void scheduled_actor::expire_request_timeouts() {
+  CAF_LOG_TRACE(CAF_ARG2("pending", request_timeouts_.size()));
+  request_timeout_tick_ = message_id{};
+  pending_request_timeout_ = disposable{};
+  auto now = clock().now();
+  auto awaited = [](message_id response_id) {
+    return [response_id](const pending_response& x) {
+      return x.first == response_id;
+    };
+  };
+  auto call = [this](behavior bhvr) {
+    if (getf(abstract_actor::collects_metrics_flag))
+      metrics_.pending_requests->dec();
+    auto msg = make_message(make_error(sec::request_timeout));
+    bhvr(msg);
+  };
+  while (!request_timeouts_.empty() && request_timeouts_.front().first <= now) {
+    std::pop_heap(request_timeouts_.begin(), request_timeouts_.end(),
+                  later_deadline);
+    auto response_id = request_timeouts_.back().second;
+    request_timeouts_.pop_back();
+    // Request IDs are unique, so we can skip requests that received their
+    // response in the meantime instead of removing them from the heap early.
+    if (auto i = multiplexed_responses_.find(response_id);
+        i != multiplexed_responses_.end()) {
+      auto bhvr = std::move(i->second);
+      multiplexed_responses_.erase(i);
+      call(std::move(bhvr));
+    } else if (std::any_of(awaited_responses_.begin(),
+                           awaited_responses_.end(), awaited(response_id))) {
+      // The actor may wait for another response first. Hence, we can only
+      // call the handler once it reaches the top of the stack. Enqueueing the
+      // error instead would put it behind a response that already arrived.
+      expired_awaited_responses_.push_back(response_id);
+    }
+  }
+  if (!expired_awaited_responses_.empty())
+    expire_awaited_responses();
+  if (!request_timeouts_.empty()) {
+    auto t = request_timeouts_.front().first;
+    if (!request_timeout_tick_.is_response() || t < next_request_timeout_)
+      schedule_request_timeout_tick(t);
+  }
+}
+
+void scheduled_actor::expire_awaited_responses() {
+  auto& xs = expired_awaited_responses_;
+  while (!awaited_responses_.empty()) {
+    auto i = std::find(xs.begin(), xs.end(), awaited_responses_.back().first);
+    if (i == xs.end())
+      return;
+    xs.erase(i);
+    auto bhvr = std::move(awaited_responses_.back().second);
+    awaited_responses_.pop_back();
+    if (getf(abstract_actor::collects_metrics_flag))
+      metrics_.pending_requests->dec();
+    auto msg = make_message(make_error(sec::request_timeout));
+    bhvr(msg);
+  }
+}
+
+void scheduled_actor::clear_response_handlers() {
+  if (getf(abstract_actor::collects_metrics_flag)) {
+    auto n = awaited_responses_.size() + multiplexed_responses_.size();
+    metrics_.pending_requests->dec(static_cast<int64_t>(n));
+  }
+  awaited_responses_.clear();
+  multiplexed_responses_.clear();
+  expired_awaited_responses_.clear();
+}
+
 // -- caf::flow bindings -------------------------------------------------------
 
 stream scheduled_actor::to_stream_impl(cow_string name, batch_op_ptr batch_op,
@@ -160,6 +160,18 @@ public:
   }
 };
 
+// Returns the number of workers for the scheduler pool `pool`.
+size_t configured_workers(const actor_system_config& cfg,
+                          const std::string& pool) {
+  auto result = get_or(cfg, "caf.scheduler.max-threads",
+                       abstract_coordinator::default_thread_count());
+  if (pool != "default") {
+    auto key = "caf.scheduler.pools." + pool + ".max-threads";
+    result = get_or(cfg, key, result);
+  }
+  return std::max(result, size_t{1});
+}
+
 } // namespace
 
 // -- implementation of coordinator --------------------------------------------
@@ -183,8 +195,59 @@ void abstract_coordinator::init(actor_system_config& cfg) {
   namespace sr = defaults::scheduler;
   max_throughput_ = get_or(cfg, "caf.scheduler.max-throughput",
                            sr::max_throughput);
-  num_workers_ = get_or(cfg, "caf.scheduler.max-threads",
-                        default_thread_count());
+  max_run_time_ = get_or(cfg, "caf.scheduler.max-run-time", sr::max_run_time);
+  drr_quantum_ = std::max(get_or(cfg, "caf.scheduler.drr-quantum",
+                                 sr::drr_quantum),
+                          size_t{1});
+  max_drr_quantum_ = std::max(get_or(cfg, "caf.scheduler.max-drr-quantum",
+                                     sr::max_drr_quantum),
+                              drr_quantum_);
+  num_workers_ = configured_num_workers();
+  stall_threshold_ = get_or(cfg, "caf.scheduler.stall-threshold",
+                            sr::stall_threshold);
+  replace_stalled_workers_ = get_or(cfg,
+                                    "caf.scheduler.replace-stalled-workers",
+                                    sr::replace_stalled_workers);
+  trace_file_ = get_or(cfg, "caf.scheduler.trace-file", sr::trace_file);
+  if (!trace_file_.empty() && !is_default_pool()) {
+    // Write the trace of a named pool to "<stem>-<pool><extension>" by default.
+    auto sep = trace_file_.find_last_of("/\\.");
+    if (sep == std::string::npos || trace_file_[sep] != '.')
+      sep = trace_file_.size();
+    auto fallback = trace_file_;
+    fallback.insert(sep, "-" + pool_name_);
+    auto key = "caf.scheduler.pools." + pool_name_ + ".trace-file";
+    trace_file_ = get_or(cfg, key, fallback);
+  }
+  trace_buffer_size_ = get_or(cfg, "caf.scheduler.trace-buffer-size",
+                              sr::trace_buffer_size);
+  trace_flush_interval_ = get_or(cfg, "caf.scheduler.trace-flush-interval",
+                                 sr::trace_flush_interval);
+  if (get_or(cfg, "caf.scheduler.pin-workers", sr::pin_workers)) {
+    topology_ = detail::cpu_topology::read();
+    // Containers usually restrict the CPUs of a process via cgroups, which
+    // the kernel reflects in the affinity mask.
+    if (std::vector<size_t> allowed; detail::get_thread_affinity(allowed))
+      topology_.restrict_to(allowed);
+    if (topology_.empty()) {
+      CAF_LOG_WARNING("unable to read the CPU topology: disable pinning");
+    } else if (!is_default_pool()) {
+      // Named pools pin their workers to the CPUs after the CPUs of the default
+      // scheduler and of all pools that precede this pool in the config.
+      auto offset = configured_workers(cfg, "default");
+      if (auto pools = get_if<settings>(&cfg, "caf.scheduler.pools"))
+        for (auto& kvp : *pools) {
+          if (kvp.first == pool_name_)
+            break;
+          offset += configured_workers(cfg, kvp.first);
+        }
+      topology_.rotate(offset);
+    }
+  }
+}
+
+size_t abstract_coordinator::configured_num_workers() const {
+  return configured_workers(config(), pool_name_);
 }
 
 actor_system::module::id_t abstract_coordinator::id() const {
@@ -203,8 +266,20 @@ void abstract_coordinator::stop_actors() {
   self->wait_for(utility_actors_);
 }
 
-abstract_coordinator::abstract_coordinator(actor_system& sys)
-  : next_worker_(0), max_throughput_(0), num_workers_(0), system_(sys) {
+abstract_coordinator::abstract_coordinator(actor_system& sys,
+                                           std::string pool_name)
+  : next_worker_(0),
+    max_throughput_(0),
+    max_run_time_(0),
+    drr_quantum_(defaults::scheduler::drr_quantum),
+    max_drr_quantum_(defaults::scheduler::max_drr_quantum),
+    stall_threshold_(0),
+    replace_stalled_workers_(false),
+    trace_buffer_size_(defaults::scheduler::trace_buffer_size),
+    trace_flush_interval_(defaults::scheduler::trace_flush_interval),
+    num_workers_(0),
+    pool_name_(std::move(pool_name)),
+    system_(sys) {
   // nop
 }
 
@@ -0,0 +1,60 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/telemetry/importer/slab_allocator.hpp"
+
+#include "caf/detail/slab_allocator.hpp"
+#include "caf/telemetry/counter.hpp"
+#include "caf/telemetry/gauge.hpp"
+#include "caf/telemetry/metric_registry.hpp"
+
+namespace caf::telemetry::importer {
+
+namespace {
+
+// Advances `x` to the total `value` read from the allocator. Reading the
+// allocator statistics is approximate, so the total may appear to go down
+// briefly. Counters must never go down, so we skip such updates.
+void advance(int_counter* x, size_t value) {
+  auto delta = static_cast<int64_t>(value) - x->value();
+  if (delta > 0)
+    x->inc(delta);
+}
+
+} // namespace
+
+slab_allocator::slab_allocator(metric_registry& reg) {
+  hits_ = reg.counter_singleton(
+    "caf.slab-allocator", "hits",
+    "Number of allocations served from a thread-local free list.", "1", true);
+  refills_ = reg.counter_singleton(
+    "caf.slab-allocator", "refills",
+    "Number of times a thread picked up blocks released by other threads.",
+    "1", true);
+  misses_ = reg.counter_singleton(
+    "caf.slab-allocator", "misses",
+    "Number of allocations that took a fresh block from a pool.", "1", true);
+  heap_allocations_ = reg.counter_singleton(
+    "caf.slab-allocator", "heap-allocations",
+    "Number of allocations that bypassed the pools.", "1", true);
+  remote_frees_ = reg.counter_singleton(
+    "caf.slab-allocator", "remote-frees",
+    "Number of blocks released by a thread other than their owner.", "1",
+    true);
+  reserved_bytes_ = reg.gauge_singleton(
+    "caf.slab-allocator", "reserved-bytes",
+    "Number of bytes that the pools reserved from the heap.", "bytes");
+}
+
+void slab_allocator::update() {
+  auto stats = detail::slab_allocator::stats();
+  advance(hits_, stats.hits);
+  advance(refills_, stats.refills);
+  advance(misses_, stats.misses);
+  advance(heap_allocations_, stats.heap_allocations);
+  advance(remote_frees_, stats.remote_frees);
+  reserved_bytes_->value(static_cast<int64_t>(stats.reserved_bytes));
+}
+
+} // namespace caf::telemetry::importer
@@ -63,6 +63,28 @@ struct fixture {
   }
 };
 
+// Blocking actors keep messages in their mailbox until calling `receive`,
+// which allows us to inspect the load of each worker after dispatching.
+struct idle_workers {
+  explicit idle_workers(actor_system& sys) : xs{sys, sys, sys} {
+    // nop
+  }
+
+  void add_to(scoped_actor& self, const actor& pool) {
+    for (auto& x : xs)
+      self->send(pool, sys_atom_v, put_atom_v, actor_cast<actor>(x));
+  }
+
+  std::vector<size_t> loads() const {
+    std::vector<size_t> result;
+    for (auto& x : xs)
+      result.push_back(x->queued_messages());
+    return result;
+  }
+
+  scoped_actor xs[3];
+};
+
 #define HANDLE_ERROR                                                           \
   [](const error& err) {                                                       \
     CAF_FAIL("AUT responded with an error: " + to_string(err));                \
@@ -160,4 +182,80 @@ CAF_TEST(random_actor_pool) {
   self->send_exit(pool, exit_reason::user_shutdown);
 }
 
+CAF_TEST(least_loaded_actor_pool) {
+  scoped_actor self{system};
+  idle_workers ws{system};
+  auto pool = actor_pool::make(&context, actor_pool::least_loaded());
+  ws.add_to(self, pool);
+  self->send(ws.xs[0], 1, 2);
+  self->send(ws.xs[0], 1, 2);
+  CHECK_EQ(ws.loads(), std::vector<size_t>({2, 0, 0}));
+  for (int i = 0; i < 4; ++i)
+    self->send(pool, 1, 2);
+  CHECK_EQ(ws.loads(), std::vector<size_t>({2, 2, 2}));
+  ws.xs[1]->receive([](int32_t, int32_t) {});
+  CHECK_EQ(ws.loads(), std::vector<size_t>({2, 1, 2}));
+  self->send(pool, 1, 2);
+  CHECK_EQ(ws.loads(), std::vector<size_t>({2, 2, 2}));
+  self->send_exit(pool, exit_reason::user_shutdown);
+}
+
+CAF_TEST(power_of_two_actor_pool) {
+  scoped_actor self{system};
+  scoped_actor w1{system};
+  scoped_actor w2{system};
+  auto pool = actor_pool::make(&context, actor_pool::power_of_two());
+  self->send(pool, sys_atom_v, put_atom_v, actor_cast<actor>(w1));
+  self->send(pool, sys_atom_v, put_atom_v, actor_cast<actor>(w2));
+  self->send(w1, 1, 2);
+  self->send(w1, 1, 2);
+  // With two workers, the policy always compares both.
+  self->send(pool, 1, 2);
+  self->send(pool, 1, 2);
+  CHECK_EQ(w1->queued_messages(), 2u);
+  CHECK_EQ(w2->queued_messages(), 2u);
+  self->send(pool, 1, 2);
+  CHECK_EQ(w1->queued_messages() + w2->queued_messages(), 5u);
+  self->send_exit(pool, exit_reason::user_shutdown);
+}
+
+CAF_TEST(consistent_hash_actor_pool) {
+  scoped_actor self{system};
+  idle_workers ws{system};
+  auto key = [](const message& msg) -> uint64_t {
+    return static_cast<uint64_t>(msg.get_as<int32_t>(0));
+  };
+  auto pool = actor_pool::make(&context, actor_pool::consistent_hash(key));
+  ws.add_to(self, pool);
+  // Returns the index of the worker that received the message for `k`.
+  auto dispatch = [&](int32_t k) -> size_t {
+    auto before = ws.loads();
+    self->send(pool, k, k);
+    auto after = ws.loads();
+    for (size_t i = 0; i < after.size(); ++i)
+      if (after[i] != before[i])
+        return i;
+    CAF_FAIL("pool dropped the message");
+  };
+  std::vector<size_t> owners;
+  for (int32_t k = 0; k < 30; ++k)
+    owners.push_back(dispatch(k));
+  MESSAGE("the same key always selects the same worker");
+  for (int32_t k = 0; k < 30; ++k)
+    CHECK_EQ(dispatch(k), owners[k]);
+  MESSAGE("the keys spread over all workers");
+  for (size_t i = 0; i < 3; ++i)
+    CHECK(std::count(owners.begin(), owners.end(), i) > 0);
+  MESSAGE("removing a worker only moves the keys of that worker");
+  self->send(pool, sys_atom_v, delete_atom_v, actor_cast<actor>(ws.xs[2]));
+  for (int32_t k = 0; k < 30; ++k) {
+    auto owner = dispatch(k);
+    if (owners[k] == 2)
+      CHECK_NE(owner, 2u);
+    else
+      CHECK_EQ(owner, owners[k]);
+  }
+  self->send_exit(pool, exit_reason::user_shutdown);
+}
+
 END_FIXTURE_SCOPE()
@@ -51,4 +51,20 @@ CAF_TEST(serialization roundtrips go through the registry) {
   anon_send_exit(hdl, exit_reason::user_shutdown);
 }
 
+CAF_TEST(actors leave the registry when terminating) {
+  // Use more actors than shards to cover each shard at least once.
+  std::vector<actor> hdls;
+  for (int i = 0; i < 100; ++i) {
+    hdls.push_back(sys.spawn(dummy));
+    sys.registry().put(hdls.back()->id(), hdls.back());
+  }
+  for (auto& hdl : hdls)
+    CHECK_EQ(sys.registry().get<actor>(hdl->id()), hdl);
+  for (auto& hdl : hdls)
+    anon_send_exit(hdl, exit_reason::user_shutdown);
+  run();
+  for (auto& hdl : hdls)
+    CHECK_EQ(sys.registry().get(hdl->id()), nullptr);
+}
+
 END_FIXTURE_SCOPE()
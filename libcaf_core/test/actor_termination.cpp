@@ -110,4 +110,31 @@ CAF_TEST(multiple_awaited_requests) {
   expect((down_msg), from(testee).to(self).with(_));
 }
 
+CAF_TEST(observers receive one message per monitor or link) {
+  spawn(mirror_impl);
+  sched.run_once();
+  self->monitor(testee);
+  self->monitor(testee);
+  self->link_to(testee);
+  anon_send_exit(testee, exit_reason::user_shutdown);
+  sched.run();
+  expect((exit_msg), from(testee).to(self).with(_));
+  expect((down_msg), from(testee).to(self).with(_));
+  expect((down_msg), from(testee).to(self).with(_));
+  disallow((down_msg), from(testee).to(self));
+}
+
+CAF_TEST(demonitor removes all monitors but no links) {
+  spawn(mirror_impl);
+  sched.run_once();
+  self->monitor(testee);
+  self->monitor(testee);
+  self->link_to(testee);
+  self->demonitor(testee);
+  anon_send_exit(testee, exit_reason::user_shutdown);
+  sched.run();
+  expect((exit_msg), from(testee).to(self).with(_));
+  disallow((down_msg), from(testee).to(self));
+}
+
 END_FIXTURE_SCOPE()
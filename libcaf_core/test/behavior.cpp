@@ -88,6 +88,58 @@ CAF_TEST(multiple_lambda_construct) {
   CHECK_EQ(res_of(f, m3), std::nullopt);
 }
 
+CAF_TEST(large_behaviors_dispatch_via_index) {
+  // Uses more handlers than default_behavior_impl::index_threshold.
+  behavior f{
+    [](int8_t) { return int32_t{1}; },
+    [](int16_t) { return int32_t{2}; },
+    [](int32_t) { return int32_t{3}; },
+    [](int64_t) { return int32_t{4}; },
+    [](uint8_t) { return int32_t{5}; },
+    [](uint16_t) { return int32_t{6}; },
+    [](uint32_t) { return int32_t{7}; },
+    [](uint64_t) { return int32_t{8}; },
+    [](int32_t, int32_t) { return int32_t{9}; },
+    [](int32_t) { return int32_t{10}; },
+    [] { return int32_t{11}; },
+  };
+  auto m0 = make_message();
+  auto m8 = make_message(uint64_t{1});
+  auto m_int8 = make_message(int8_t{1});
+  auto m_str = make_message(std::string{"hello"});
+  CHECK_EQ(res_of(f, m_int8), 1);
+  CHECK_EQ(res_of(f, m8), 8);
+  CHECK_EQ(res_of(f, m2), 9);
+  CHECK_EQ(res_of(f, m0), 11);
+  CHECK_EQ(f(m_str), std::nullopt);
+  CHECK_EQ(f(m3), std::nullopt);
+  MESSAGE("the first handler wins if two handlers accept the same types");
+  CHECK_EQ(res_of(f, m1), 3);
+}
+
+CAF_TEST(rvalue_handlers_move_from_unique_messages) {
+  std::string received;
+  behavior f{
+    [&received](std::string&& x, int32_t) { received = std::move(x); },
+  };
+  auto str = std::string(100, 'x');
+  MESSAGE("a unique message hands its content over to the handler");
+  auto msg = make_message(str, int32_t{1});
+  auto data = msg.get_as<std::string>(0).data();
+  CHECK(f(msg));
+  CHECK_EQ(received, str);
+  CHECK(received.data() == data);
+  MESSAGE("a shared message detaches before handing over its content");
+  msg = make_message(str, int32_t{1});
+  auto copy = msg;
+  data = msg.get_as<std::string>(0).data();
+  CHECK(f(msg));
+  CHECK_EQ(received, str);
+  CHECK(received.data() != data);
+  CHECK_EQ(copy.get_as<std::string>(0), str);
+  CHECK(copy.get_as<std::string>(0).data() == data);
+}
+
 CAF_TEST(become_empty_behavior) {
   actor_system_config cfg{};
   actor_system sys{cfg};
@@ -0,0 +1,172 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE bounded_mailbox
+
+#include "caf/all.hpp"
+
+#include "core-test.hpp"
+
+#include "caf/detail/latch.hpp"
+
+#include <atomic>
+#include <thread>
+
+using namespace caf;
+using namespace std::literals;
+
+namespace {
+
+using log_ptr = std::shared_ptr<std::vector<int32_t>>;
+
+behavior recorder(event_based_actor*, log_ptr log) {
+  return {
+    [log](int32_t x) {
+      log->push_back(x);
+      return x;
+    },
+  };
+}
+
+struct fixture : test_coordinator_fixture<> {
+  int64_t dropped_messages() {
+    return sys.base_metrics().dropped_messages->value();
+  }
+
+  log_ptr log = std::make_shared<std::vector<int32_t>>();
+};
+
+} // namespace
+
+BEGIN_FIXTURE_SCOPE(fixture)
+
+SCENARIO("drop_newest drops messages that arrive at a full mailbox") {
+  GIVEN("an actor with a mailbox capacity of 2") {
+    auto aut = sys.spawn_bounded(2, mailbox_overflow_policy::drop_newest,
+                                 recorder, log);
+    WHEN("sending three messages before the actor runs") {
+      for (int32_t i = 1; i <= 3; ++i)
+        self->send(aut, i);
+      run();
+      THEN("the actor receives the first two messages") {
+        CHECK_EQ(*log, std::vector<int32_t>({1, 2}));
+        CHECK_EQ(dropped_messages(), 1);
+      }
+      AND_THEN("the actor accepts new messages after processing its mailbox") {
+        self->send(aut, 4);
+        run();
+        CHECK_EQ(*log, std::vector<int32_t>({1, 2, 4}));
+        CHECK_EQ(dropped_messages(), 1);
+      }
+    }
+  }
+}
+
+SCENARIO("the drop_oldest policy drops the oldest messages in the mailbox") {
+  GIVEN("an actor with a mailbox capacity of 2") {
+    auto aut = sys.spawn_bounded(2, mailbox_overflow_policy::drop_oldest,
+                                 recorder, log);
+    WHEN("sending four messages before the actor runs") {
+      for (int32_t i = 1; i <= 4; ++i)
+        self->send(aut, i);
+      run();
+      THEN("the actor receives the last two messages") {
+        CHECK_EQ(*log, std::vector<int32_t>({3, 4}));
+        CHECK_EQ(dropped_messages(), 2);
+      }
+    }
+  }
+}
+
+SCENARIO("the reject policy responds to requests with mailbox_full") {
+  GIVEN("an actor with a full mailbox") {
+    auto aut = sys.spawn_bounded(1, mailbox_overflow_policy::reject, recorder,
+                                 log);
+    self->send(aut, 1);
+    WHEN("sending a request") {
+      THEN("the sender receives an error") {
+        self->request(aut, infinite, int32_t{2})
+          .receive([](int32_t) { CAF_FAIL("expected an error"); },
+                   [](const error& err) { CHECK_EQ(err, sec::mailbox_full); });
+        CHECK_EQ(dropped_messages(), 1);
+        run();
+        CHECK_EQ(*log, std::vector<int32_t>({1}));
+      }
+    }
+  }
+}
+
+SCENARIO("responses bypass the capacity of the mailbox") {
+  GIVEN("an actor with a mailbox capacity of 1 that sends a request") {
+    auto server = sys.spawn([]() -> behavior {
+      return {
+        [](int32_t x) { return x * 2; },
+      };
+    });
+    auto aut = sys.spawn_bounded(
+      1, mailbox_overflow_policy::drop_newest,
+      [server, log = log](event_based_actor* self) -> behavior {
+        return {
+          [=](int32_t x) {
+            self->request(server, infinite, x)
+              .await([=](int32_t y) { log->push_back(y); });
+          },
+        };
+      });
+    WHEN("the mailbox is full when the response arrives") {
+      self->send(aut, 1);
+      expect((int32_t), from(self).to(aut).with(1));
+      self->send(aut, 2);
+      expect((int32_t), from(aut).to(server).with(1));
+      THEN("the actor receives the response anyway") {
+        expect((int32_t), from(server).to(aut).with(2));
+        CHECK_EQ(*log, std::vector<int32_t>({2}));
+        CHECK_EQ(dropped_messages(), 0);
+      }
+    }
+  }
+}
+
+END_FIXTURE_SCOPE()
+
+SCENARIO("the block policy blocks senders until the mailbox has room") {
+  GIVEN("an actor with a mailbox capacity of 2 that is busy") {
+    actor_system_config cfg;
+    actor_system sys{cfg};
+    auto gate = std::make_shared<detail::latch>(2);
+    auto aut = sys.spawn_bounded(
+      2, mailbox_overflow_policy::block, [gate]() -> behavior {
+        auto received = std::make_shared<int32_t>(0);
+        return {
+          [gate, received](int32_t x) {
+            if (x == 1)
+              gate->count_down_and_wait();
+            ++*received;
+          },
+          [received](get_atom) { return *received; },
+        };
+      });
+    WHEN("a scoped actor sends more messages than the mailbox can hold") {
+      THEN("the sender waits until the actor processes its messages") {
+        std::atomic<bool> done = false;
+        std::thread sender{[&] {
+          scoped_actor self{sys};
+          for (int32_t i = 1; i <= 4; ++i)
+            self->send(aut, i);
+          done = true;
+        }};
+        std::this_thread::sleep_for(50ms);
+        CHECK(!done);
+        gate->count_down();
+        sender.join();
+        CHECK(done);
+        scoped_actor self{sys};
+        self->request(aut, infinite, get_atom_v)
+          .receive([](int32_t n) { CHECK_EQ(n, 4); },
+                   [](const error& err) { CAF_FAIL(to_string(err)); });
+        CHECK_EQ(sys.base_metrics().dropped_messages->value(), 0);
+      }
+    }
+  }
+}
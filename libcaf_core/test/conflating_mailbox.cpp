@@ -0,0 +1,100 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE conflating_mailbox
+
+#include "caf/all.hpp"
+
+#include "core-test.hpp"
+
+using namespace caf;
+
+namespace {
+
+using log_ptr = std::shared_ptr<std::vector<std::string>>;
+
+// Keeps only the latest price per symbol.
+behavior ticker(event_based_actor* self, log_ptr log) {
+  self->conflate<std::string, int32_t>(
+    [](const std::string& symbol, int32_t) { return symbol; });
+  return {
+    [log](const std::string& symbol, int32_t price) {
+      log->push_back(symbol + ":" + std::to_string(price));
+    },
+    [log](int32_t x) { log->push_back(std::to_string(x)); },
+  };
+}
+
+struct fixture : test_coordinator_fixture<> {
+  int64_t conflated_messages() {
+    return sys.base_metrics().conflated_messages->value();
+  }
+
+  log_ptr log = std::make_shared<std::vector<std::string>>();
+};
+
+} // namespace
+
+BEGIN_FIXTURE_SCOPE(fixture)
+
+SCENARIO("conflating actors only process the latest message per key") {
+  GIVEN("an actor that conflates quotes by their symbol") {
+    auto aut = sys.spawn(ticker, log);
+    run();
+    WHEN("sending multiple quotes per symbol before the actor runs") {
+      self->send(aut, "A", int32_t{1});
+      self->send(aut, "B", int32_t{1});
+      self->send(aut, int32_t{7});
+      self->send(aut, "A", int32_t{2});
+      self->send(aut, int32_t{8});
+      self->send(aut, "A", int32_t{3});
+      self->send(aut, "B", int32_t{2});
+      run();
+      THEN("the latest quote takes the position of the first quote") {
+        CHECK_EQ(*log, std::vector<std::string>({"A:3", "B:2", "7", "8"}));
+        CHECK_EQ(conflated_messages(), 3);
+      }
+    }
+  }
+}
+
+SCENARIO("conflating actors process messages that arrive after a run") {
+  GIVEN("an actor that conflates quotes by their symbol") {
+    auto aut = sys.spawn(ticker, log);
+    run();
+    WHEN("sending quotes after the actor processed older quotes") {
+      self->send(aut, "A", int32_t{1});
+      run();
+      self->send(aut, "A", int32_t{2});
+      run();
+      THEN("the actor processes all quotes") {
+        CHECK_EQ(*log, std::vector<std::string>({"A:1", "A:2"}));
+        CHECK_EQ(conflated_messages(), 0);
+      }
+    }
+  }
+}
+
+SCENARIO("conflating actors never conflate requests") {
+  GIVEN("an actor that conflates quotes by their symbol") {
+    auto aut = sys.spawn(ticker, log);
+    run();
+    WHEN("sending requests with the same key") {
+      self->send(aut, "A", int32_t{1});
+      auto client = sys.spawn([aut](event_based_actor* client) {
+        client->request(aut, infinite, "A", int32_t{2}).then([] {});
+      });
+      sched.prioritize(client);
+      sched.run_once();
+      self->send(aut, "A", int32_t{3});
+      run();
+      THEN("requests never replace or get replaced by other messages") {
+        CHECK_EQ(*log, std::vector<std::string>({"A:3", "A:2"}));
+        CHECK_EQ(conflated_messages(), 1);
+      }
+    }
+  }
+}
+
+END_FIXTURE_SCOPE()
@@ -0,0 +1,155 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE detail.cpu_topology
+
+#include "caf/detail/cpu_topology.hpp"
+
+#include "core-test.hpp"
+
+using namespace caf;
+
+using detail::cpu_locality;
+using detail::cpu_location;
+using detail::cpu_topology;
+
+namespace {
+
+using id_list = std::vector<size_t>;
+
+id_list parse(std::string_view str) {
+  id_list result;
+  if (!detail::parse_cpu_list(str, result))
+    CAF_FAIL("failed to parse " << str);
+  return result;
+}
+
+bool parse_fails(std::string_view str) {
+  id_list result;
+  return !detail::parse_cpu_list(str, result);
+}
+
+// Two NUMA nodes with two L3 caches each and two CPUs per L3 cache. The CPU
+// IDs interleave the nodes, as is common on multi-socket machines.
+cpu_topology make_two_socket_topology() {
+  return cpu_topology{{
+    {0, 0, 0},
+    {1, 1, 1},
+    {2, 0, 0},
+    {3, 1, 1},
+    {4, 4, 0},
+    {5, 5, 1},
+    {6, 4, 0},
+    {7, 5, 1},
+  }};
+}
+
+} // namespace
+
+SCENARIO("parse_cpu_list reads the sysfs list format") {
+  GIVEN("valid CPU lists") {
+    WHEN("parsing them") {
+      THEN("the result contains all CPUs in the list") {
+        CHECK_EQ(parse("0"), id_list({0}));
+        CHECK_EQ(parse("0-3\n"), id_list({0, 1, 2, 3}));
+        CHECK_EQ(parse("0-1,4,6-7"), id_list({0, 1, 4, 6, 7}));
+      }
+    }
+  }
+  GIVEN("invalid CPU lists") {
+    WHEN("parsing them") {
+      THEN("parse_cpu_list returns false") {
+        CHECK(parse_fails(""));
+        CHECK(parse_fails("\n"));
+        CHECK(parse_fails("a"));
+        CHECK(parse_fails("3-1"));
+        CHECK(parse_fails("1,"));
+        CHECK(parse_fails("-1"));
+      }
+    }
+  }
+}
+
+SCENARIO("topologies order CPUs by NUMA node and L3 cache") {
+  GIVEN("a topology for a machine with two sockets") {
+    auto uut = make_two_socket_topology();
+    WHEN("assigning CPUs to workers") {
+      THEN("consecutive workers run on nearby CPUs") {
+        REQUIRE_EQ(uut.size(), 8u);
+        id_list cpus;
+        for (size_t worker = 0; worker < uut.size(); ++worker)
+          cpus.emplace_back(uut.cpu_for_worker(worker).cpu);
+        CHECK_EQ(cpus, id_list({0, 2, 4, 6, 1, 3, 5, 7}));
+        CHECK_EQ(uut.cpu_for_worker(8).cpu, 0u);
+      }
+    }
+    WHEN("computing the locality of two workers") {
+      THEN("the locality reflects the shared cache or node") {
+        CHECK_EQ(uut.worker_locality(0, 1), cpu_locality::same_l3);
+        CHECK_EQ(uut.worker_locality(0, 2), cpu_locality::same_node);
+        CHECK_EQ(uut.worker_locality(0, 4), cpu_locality::remote);
+        CHECK_EQ(uut.worker_locality(0, 8), cpu_locality::same_l3);
+      }
+    }
+  }
+}
+
+SCENARIO("rotating a topology shifts workers to other CPUs") {
+  GIVEN("a topology for a machine with two sockets") {
+    auto uut = make_two_socket_topology();
+    WHEN("rotating the topology by three") {
+      THEN("worker 0 runs on the CPU of worker 3") {
+        uut.rotate(3);
+        id_list cpus;
+        for (size_t worker = 0; worker < uut.size(); ++worker)
+          cpus.emplace_back(uut.cpu_for_worker(worker).cpu);
+        CHECK_EQ(cpus, id_list({6, 1, 3, 5, 7, 0, 2, 4}));
+      }
+    }
+    WHEN("rotating the topology by more than its size") {
+      THEN("the offset wraps around") {
+        uut = make_two_socket_topology();
+        uut.rotate(9);
+        CHECK_EQ(uut.cpu_for_worker(0).cpu, 2u);
+      }
+    }
+  }
+}
+
+SCENARIO("topologies only contain CPUs that the process may use") {
+  GIVEN("a topology for a machine with two sockets") {
+    auto uut = make_two_socket_topology();
+    WHEN("restricting the topology to a subset of its CPUs") {
+      THEN("workers only run on CPUs in that subset") {
+        uut.restrict_to({1, 2, 3, 6, 42});
+        REQUIRE_EQ(uut.size(), 4u);
+        id_list cpus;
+        for (size_t worker = 0; worker < uut.size(); ++worker)
+          cpus.emplace_back(uut.cpu_for_worker(worker).cpu);
+        CHECK_EQ(cpus, id_list({2, 6, 1, 3}));
+        CHECK_EQ(uut.worker_locality(0, 1), cpu_locality::same_node);
+        CHECK_EQ(uut.worker_locality(2, 3), cpu_locality::same_l3);
+      }
+    }
+  }
+  GIVEN("the affinity mask of the current thread") {
+    WHEN("reading it") {
+      THEN("the mask contains at least one CPU on supported platforms") {
+        id_list allowed;
+        if (detail::get_thread_affinity(allowed))
+          CHECK(!allowed.empty());
+      }
+    }
+  }
+}
+
+SCENARIO("reading the topology fails gracefully for invalid sysfs paths") {
+  GIVEN("a path that does not exist") {
+    WHEN("calling cpu_topology::read") {
+      THEN("the result is an empty topology") {
+        CHECK(cpu_topology::read("/this/path/does/not/exist").empty());
+      }
+    }
+  }
+}
@@ -0,0 +1,86 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE detail.double_ended_queue
+
+#include "caf/detail/double_ended_queue.hpp"
+
+#include "core-test.hpp"
+
+#include <iterator>
+#include <vector>
+
+using namespace caf;
+
+namespace {
+
+struct fixture {
+  // Replaces the content of the queue with the first `n` values, starting at
+  // index 1. The steps of a scenario share the fixture, so each step that
+  // modifies the queue needs to start from a known state.
+  void fill(size_t n) {
+    while (uut.try_take_head() != nullptr)
+      ; // nop
+    for (size_t i = 1; i <= n; ++i)
+      uut.append(&values[i]);
+  }
+
+  detail::double_ended_queue<int> uut;
+  std::array<int, 10> values = {{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}};
+};
+
+} // namespace
+
+BEGIN_FIXTURE_SCOPE(fixture)
+
+SCENARIO("the owner takes from the head while others take from the tail") {
+  GIVEN("a queue with three elements") {
+    uut.append(&values[1]);
+    uut.append(&values[2]);
+    uut.prepend(&values[0]);
+    WHEN("taking elements from both ends") {
+      THEN("the head is the most recently prepended element") {
+        CHECK_EQ(uut.try_take_head(), &values[0]);
+        CHECK_EQ(uut.try_take_tail(), &values[2]);
+        CHECK_EQ(uut.try_take_tail(), &values[1]);
+        CHECK_EQ(uut.try_take_head(), nullptr);
+        CHECK_EQ(uut.try_take_tail(), nullptr);
+      }
+    }
+  }
+}
+
+SCENARIO("try_take_tail_half takes up to half of the elements") {
+  GIVEN("a queue with five elements") {
+    WHEN("calling try_take_tail_half") {
+      THEN("the caller receives the newest elements first") {
+        fill(5);
+        std::vector<int*> taken;
+        CHECK_EQ(uut.try_take_tail_half(10, std::back_inserter(taken)), 3u);
+        auto expected = std::vector<int*>{&values[5], &values[4], &values[3]};
+        CHECK_EQ(taken, expected);
+        CHECK_EQ(uut.try_take_head(), &values[1]);
+      }
+    }
+    WHEN("calling try_take_tail_half with a small maximum") {
+      THEN("the caller receives no more than the maximum") {
+        fill(5);
+        std::vector<int*> taken;
+        CHECK_EQ(uut.try_take_tail_half(1, std::back_inserter(taken)), 1u);
+        CHECK_EQ(taken, std::vector<int*>({&values[5]}));
+      }
+    }
+  }
+  GIVEN("an empty queue") {
+    WHEN("calling try_take_tail_half") {
+      THEN("the caller receives nothing") {
+        fill(0);
+        std::vector<int*> taken;
+        CHECK_EQ(uut.try_take_tail_half(10, std::back_inserter(taken)), 0u);
+      }
+    }
+  }
+}
+
+END_FIXTURE_SCOPE()
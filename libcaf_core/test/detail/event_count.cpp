@@ -0,0 +1,75 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE detail.event_count
+
+#include "caf/detail/event_count.hpp"
+
+#include "core-test.hpp"
+
+#include <atomic>
+#include <thread>
+
+using namespace caf;
+
+SCENARIO("notify_one is a no-op without waiters") {
+  GIVEN("an event count without waiters") {
+    detail::event_count uut;
+    WHEN("calling notify_one") {
+      THEN("only notifications after prepare_wait release the waiter") {
+        uut.notify_one();
+        auto key = uut.prepare_wait();
+        CHECK_EQ(uut.num_waiters(), 1u);
+        uut.notify_one();
+        uut.wait(key);
+        CHECK_EQ(uut.num_waiters(), 0u);
+      }
+    }
+  }
+}
+
+SCENARIO("cancel_wait unregisters a waiter") {
+  GIVEN("an event count with one registered waiter") {
+    detail::event_count uut;
+    uut.prepare_wait();
+    WHEN("calling cancel_wait") {
+      THEN("the event count has no waiters") {
+        CHECK_EQ(uut.num_waiters(), 1u);
+        uut.cancel_wait();
+        CHECK_EQ(uut.num_waiters(), 0u);
+      }
+    }
+  }
+}
+
+SCENARIO("parked threads never miss a notification") {
+  GIVEN("a consumer thread that parks until a flag becomes true") {
+    detail::event_count uut;
+    std::atomic<int> items = 0;
+    std::atomic<int> consumed = 0;
+    WHEN("a producer sets the flag and calls notify_one") {
+      THEN("the consumer wakes up and observes each item") {
+        constexpr int num_items = 1000;
+        std::thread consumer{[&] {
+          while (consumed < num_items) {
+            auto key = uut.prepare_wait();
+            if (items.load() > consumed.load()) {
+              uut.cancel_wait();
+              ++consumed;
+              continue;
+            }
+            uut.wait(key);
+          }
+        }};
+        for (int i = 0; i < num_items; ++i) {
+          ++items;
+          uut.notify_one();
+        }
+        consumer.join();
+        CHECK_EQ(consumed.load(), num_items);
+        CHECK_EQ(uut.num_waiters(), 0u);
+      }
+    }
+  }
+}
@@ -0,0 +1,89 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE detail.mailbox_bound
+
+#include "caf/detail/mailbox_bound.hpp"
+
+#include "core-test.hpp"
+
+#include <atomic>
+#include <thread>
+
+using namespace caf;
+using namespace std::literals;
+
+SCENARIO("mailbox bounds limit the number of reserved slots") {
+  GIVEN("a bound with capacity 2") {
+    detail::mailbox_bound uut{2, mailbox_overflow_policy::reject};
+    WHEN("reserving slots") {
+      THEN("try_reserve fails after reaching the capacity") {
+        CHECK(uut.try_reserve());
+        CHECK(uut.try_reserve());
+        CHECK(!uut.try_reserve());
+        CHECK_EQ(uut.size(), 2u);
+        CHECK_EQ(uut.excess(), 0u);
+      }
+      AND_THEN("try_reserve succeeds again after releasing a slot") {
+        uut.release();
+        CHECK(uut.try_reserve());
+        CHECK(!uut.try_reserve());
+      }
+    }
+  }
+}
+
+SCENARIO("forced reservations may exceed the capacity") {
+  GIVEN("a bound with capacity 1") {
+    detail::mailbox_bound uut{1, mailbox_overflow_policy::drop_oldest};
+    WHEN("forcing three reservations") {
+      uut.force_reserve();
+      uut.force_reserve();
+      uut.force_reserve();
+      THEN("excess returns the number of slots above the capacity") {
+        CHECK_EQ(uut.size(), 3u);
+        CHECK_EQ(uut.excess(), 2u);
+        uut.release(2);
+        CHECK_EQ(uut.excess(), 0u);
+      }
+    }
+  }
+}
+
+SCENARIO("reserve_or_wait blocks until a slot becomes available") {
+  GIVEN("a full bound") {
+    detail::mailbox_bound uut{1, mailbox_overflow_policy::block};
+    CHECK(uut.try_reserve());
+    WHEN("another thread calls reserve_or_wait") {
+      THEN("the thread continues after releasing a slot") {
+        std::atomic<bool> reserved = false;
+        std::thread waiter{[&] { reserved = uut.reserve_or_wait(); }};
+        std::this_thread::sleep_for(10ms);
+        CHECK(!reserved);
+        uut.release();
+        waiter.join();
+        CHECK(reserved);
+        CHECK_EQ(uut.size(), 1u);
+      }
+    }
+  }
+}
+
+SCENARIO("closing a bound wakes up all waiting threads") {
+  GIVEN("a full bound") {
+    detail::mailbox_bound uut{1, mailbox_overflow_policy::block};
+    CHECK(uut.try_reserve());
+    WHEN("closing the bound while another thread waits for a slot") {
+      THEN("reserve_or_wait returns false without reserving a slot") {
+        std::atomic<bool> reserved = true;
+        std::thread waiter{[&] { reserved = uut.reserve_or_wait(); }};
+        std::this_thread::sleep_for(10ms);
+        uut.close();
+        waiter.join();
+        CHECK(!reserved);
+        CHECK_EQ(uut.size(), 1u);
+      }
+    }
+  }
+}
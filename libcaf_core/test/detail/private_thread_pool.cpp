@@ -12,7 +12,41 @@
 
 using namespace caf;
 
-BEGIN_FIXTURE_SCOPE(test_coordinator_fixture<>)
+namespace {
+
+template <class Config>
+struct fixture : test_coordinator_fixture<Config> {
+  int64_t private_threads() {
+    return this->sys.base_metrics().private_threads->value();
+  }
+
+  int64_t reused_private_threads() {
+    return this->sys.base_metrics().reused_private_threads->value();
+  }
+
+  // Blocks until the pool has `n` threads.
+  void await_private_threads(int64_t n) {
+    using namespace std::literals::chrono_literals;
+    while (private_threads() != n)
+      std::this_thread::sleep_for(1ms);
+  }
+};
+
+struct bounded_config : actor_system_config {
+  bounded_config() {
+    set("caf.private-threads.max-idle", size_t{1});
+  }
+};
+
+struct short_timeout_config : actor_system_config {
+  short_timeout_config() {
+    set("caf.private-threads.idle-timeout", timespan{1'000'000});
+  }
+};
+
+} // namespace
+
+BEGIN_FIXTURE_SCOPE(fixture<actor_system_config>)
 
 SCENARIO("private threads count towards detached actors") {
   GIVEN("an actor system with a private thread pool") {
@@ -74,7 +108,7 @@ SCENARIO("private threads rerun their resumable when it returns resume_later") {
         sys.release_private_thread(t);
         while (f.runs != 2u)
           std::this_thread::sleep_for(1ms);
-        while (sys.detached_actors() != 0)
+        while (sys.detached_actors() != 0 || f.refs_released == 0u)
           std::this_thread::sleep_for(1ms);
         CHECK_EQ(f.refs_added, 0u);
         CHECK_EQ(f.refs_released, 1u);
@@ -83,4 +117,59 @@ SCENARIO("private threads rerun their resumable when it returns resume_later") {
   }
 }
 
+SCENARIO("the private thread pool reuses released threads") {
+  GIVEN("an actor system with a private thread pool") {
+    WHEN("acquiring a thread after releasing another thread") {
+      THEN("the pool returns the idle thread instead of launching a new one") {
+        auto t1 = sys.acquire_private_thread();
+        CHECK_EQ(private_threads(), 1);
+        sys.release_private_thread(t1);
+        CHECK_EQ(sys.detached_actors(), 0u);
+        auto t2 = sys.acquire_private_thread();
+        CHECK_EQ(t1, t2);
+        CHECK_EQ(private_threads(), 1);
+        CHECK_EQ(reused_private_threads(), 1);
+        sys.release_private_thread(t2);
+      }
+    }
+  }
+}
+
+END_FIXTURE_SCOPE()
+
+BEGIN_FIXTURE_SCOPE(fixture<bounded_config>)
+
+SCENARIO("the private thread pool stops threads exceeding max-idle") {
+  GIVEN("an actor system that keeps at most one idle thread") {
+    WHEN("releasing two threads") {
+      THEN("the pool stops one of them") {
+        auto t1 = sys.acquire_private_thread();
+        auto t2 = sys.acquire_private_thread();
+        CHECK_EQ(private_threads(), 2);
+        sys.release_private_thread(t1);
+        sys.release_private_thread(t2);
+        await_private_threads(1);
+        CHECK_EQ(sys.detached_actors(), 0u);
+      }
+    }
+  }
+}
+
+END_FIXTURE_SCOPE()
+
+BEGIN_FIXTURE_SCOPE(fixture<short_timeout_config>)
+
+SCENARIO("the private thread pool stops threads after the idle timeout") {
+  GIVEN("an actor system with an idle timeout of one millisecond") {
+    WHEN("releasing a thread") {
+      THEN("the pool eventually stops the thread") {
+        auto t1 = sys.acquire_private_thread();
+        CHECK_EQ(private_threads(), 1);
+        sys.release_private_thread(t1);
+        await_private_threads(0);
+      }
+    }
+  }
+}
+
 END_FIXTURE_SCOPE()
@@ -0,0 +1,221 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE detail.slab_allocator
+
+#include "caf/detail/slab_allocator.hpp"
+
+#include "core-test.hpp"
+
+#include "caf/mailbox_element.hpp"
+#include "caf/telemetry/counter.hpp"
+#include "caf/telemetry/importer/slab_allocator.hpp"
+#include "caf/telemetry/metric_registry.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace caf;
+
+using detail::slab_allocator;
+
+namespace {
+
+// Counts how many allocations hit the pools or the heap between construction
+// and calling `delta`.
+struct allocation_counter {
+  allocation_counter() : before(slab_allocator::stats()) {
+    // nop
+  }
+
+  slab_allocator::statistics delta() const {
+    auto after = slab_allocator::stats();
+    return {after.hits - before.hits, after.refills - before.refills,
+            after.misses - before.misses,
+            after.heap_allocations - before.heap_allocations,
+            after.remote_frees - before.remote_frees,
+            after.reserved_bytes - before.reserved_bytes};
+  }
+
+  slab_allocator::statistics before;
+};
+
+std::vector<void*> allocate_n(size_t n, size_t size) {
+  std::vector<void*> result;
+  for (size_t i = 0; i < n; ++i)
+    result.push_back(slab_allocator::allocate(size));
+  return result;
+}
+
+void deallocate_all(const std::vector<void*>& blocks) {
+  for (auto ptr : blocks)
+    slab_allocator::deallocate(ptr);
+}
+
+} // namespace
+
+SCENARIO("the slab allocator returns aligned and distinct blocks") {
+  GIVEN("blocks of various sizes") {
+    WHEN("allocating them") {
+      THEN("each block is aligned and usable") {
+        std::vector<void*> blocks;
+        for (size_t size = 1; size <= 2 * slab_allocator::max_block_size;
+             size += 7)
+          blocks.push_back(slab_allocator::allocate(size));
+        for (auto ptr : blocks) {
+          CHECK_NE(ptr, nullptr);
+          auto addr = reinterpret_cast<uintptr_t>(ptr);
+          CHECK_EQ(addr % alignof(std::max_align_t), 0u);
+        }
+        auto sorted = blocks;
+        std::sort(sorted.begin(), sorted.end());
+        CHECK(std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end());
+        deallocate_all(blocks);
+      }
+    }
+  }
+}
+
+SCENARIO("threads reuse the blocks they released") {
+  if (!slab_allocator::enabled)
+    return;
+  GIVEN("a thread that allocates 100 blocks and releases them again") {
+    WHEN("allocating 100 blocks of the same size class again") {
+      THEN("all allocations hit the thread-local free list") {
+        std::thread worker{[] {
+          deallocate_all(allocate_n(100, 64));
+          allocation_counter counter;
+          auto blocks = allocate_n(100, 60);
+          auto stats = counter.delta();
+          CHECK_EQ(stats.hits, 100u);
+          CHECK_EQ(stats.misses, 0u);
+          CHECK_EQ(stats.heap_allocations, 0u);
+          CHECK_EQ(stats.reserved_bytes, 0u);
+          deallocate_all(blocks);
+        }};
+        worker.join();
+      }
+    }
+  }
+  GIVEN("a block that exceeds the largest size class") {
+    WHEN("allocating the block") {
+      THEN("the allocator falls back to the heap") {
+        allocation_counter counter;
+        auto ptr = slab_allocator::allocate(slab_allocator::max_block_size + 1);
+        slab_allocator::deallocate(ptr);
+        CHECK_EQ(counter.delta().heap_allocations, 1u);
+      }
+    }
+  }
+}
+
+SCENARIO("threads return released blocks of other threads in batches") {
+  if (!slab_allocator::enabled)
+    return;
+  GIVEN("a producer thread that allocates blocks for a consumer thread") {
+    WHEN("the consumer releases the blocks") {
+      THEN("the producer picks up the blocks instead of taking new ones") {
+        std::thread producer{[] {
+          auto blocks = allocate_n(256, 96);
+          allocation_counter counter;
+          std::thread consumer{[&blocks] {
+            deallocate_all(blocks);
+            slab_allocator::flush();
+          }};
+          consumer.join();
+          CHECK_EQ(counter.delta().remote_frees, 256u);
+          blocks = allocate_n(256, 96);
+          auto stats = counter.delta();
+          CHECK_EQ(stats.hits, 256u);
+          CHECK_EQ(stats.misses, 0u);
+          // 256 blocks in batches of 32 require at most one refill.
+          CHECK_LE(stats.refills, 1u);
+          deallocate_all(blocks);
+        }};
+        producer.join();
+      }
+    }
+  }
+}
+
+SCENARIO("pairs of blocks share a single allocation") {
+  GIVEN("a pair of blocks") {
+    WHEN("releasing the blocks in any order and on any thread") {
+      THEN("the allocator reclaims the memory after releasing both blocks") {
+        allocation_counter counter;
+        auto [first, second] = slab_allocator::allocate_pair(72, 40);
+        auto stats = counter.delta();
+        CHECK_EQ(stats.hits + stats.misses + stats.heap_allocations, 1u);
+        REQUIRE_NE(first, nullptr);
+        REQUIRE_NE(second, nullptr);
+        for (auto ptr : {first, second}) {
+          auto addr = reinterpret_cast<uintptr_t>(ptr);
+          CHECK_EQ(addr % alignof(std::max_align_t), 0u);
+        }
+        CHECK_GE(static_cast<std::byte*>(second),
+                 static_cast<std::byte*>(first) + 72);
+        std::memset(first, 0xFF, 72);
+        std::memset(second, 0xFF, 40);
+        std::thread consumer{[ptr = second] {
+          slab_allocator::deallocate(ptr);
+        }};
+        consumer.join();
+        slab_allocator::deallocate(first);
+      }
+    }
+  }
+}
+
+SCENARIO("mailbox elements and messages use the slab allocator") {
+  if (!slab_allocator::enabled)
+    return;
+  GIVEN("a thread that creates mailbox elements") {
+    WHEN("creating a mailbox element with a small message") {
+      THEN("both objects share a single block from the pools") {
+        std::thread worker{[] {
+          allocation_counter counter;
+          auto elem = make_mailbox_element(nullptr, make_message_id(), {},
+                                           int32_t{42});
+          auto stats = counter.delta();
+          CHECK_EQ(stats.hits + stats.misses, 1u);
+          CHECK_EQ(stats.heap_allocations, 0u);
+          CHECK_EQ(elem->payload.get_as<int32_t>(0), 42);
+        }};
+        worker.join();
+      }
+    }
+  }
+}
+
+SCENARIO("the importer exports the allocator statistics as counters") {
+  GIVEN("a metric registry with a slab allocator importer") {
+    telemetry::metric_registry reg;
+    telemetry::importer::slab_allocator uut{reg};
+    WHEN("threads allocate memory between two updates") {
+      THEN("the counters grow by the number of allocations") {
+        uut.update();
+        // Note: the lookup must use the same unit and is-sum flag as the
+        //       importer, otherwise the registry rejects it.
+        auto get = [&reg](std::string_view name) {
+          return reg.counter_singleton("caf.slab-allocator", name, "", "1",
+                                       true);
+        };
+        auto hits = get("hits");
+        auto misses = get("misses");
+        auto heap = get("heap-allocations");
+        auto total = [&] {
+          return hits->value() + misses->value() + heap->value();
+        };
+        auto before = total();
+        deallocate_all(allocate_n(10, 32));
+        uut.update();
+        CHECK_GE(total(), before + 10);
+      }
+    }
+  }
+}
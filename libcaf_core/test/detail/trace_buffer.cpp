@@ -0,0 +1,114 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE detail.trace_buffer
+
+#include "caf/detail/trace_buffer.hpp"
+
+#include "core-test.hpp"
+
+#include <thread>
+#include <vector>
+
+using namespace caf;
+
+using detail::trace_event;
+using detail::trace_event_type;
+
+namespace {
+
+std::vector<uint64_t> drain_values(detail::trace_buffer& buf) {
+  std::vector<uint64_t> result;
+  buf.drain([&result](const trace_event& x) { result.push_back(x.value); });
+  return result;
+}
+
+} // namespace
+
+SCENARIO("the consumer receives trace events in FIFO order") {
+  GIVEN("a trace buffer with three events") {
+    detail::trace_buffer uut{0, 8};
+    uut.push(trace_event_type::resume_begin, 1);
+    uut.push(trace_event_type::messages, 2);
+    uut.push(trace_event_type::resume_end, 3);
+    WHEN("draining the buffer") {
+      THEN("the consumer receives all events in order") {
+        std::vector<trace_event> events;
+        auto n = uut.drain([&](const trace_event& x) { events.push_back(x); });
+        CHECK_EQ(n, 3u);
+        if (CHECK_EQ(events.size(), 3u)) {
+          CHECK(events[0].type == trace_event_type::resume_begin);
+          CHECK(events[1].type == trace_event_type::messages);
+          CHECK(events[2].type == trace_event_type::resume_end);
+          CHECK_EQ(events[0].value, 1u);
+          CHECK_EQ(events[2].value, 3u);
+          CHECK_LE(events[0].timestamp, events[1].timestamp);
+          CHECK_LE(events[1].timestamp, events[2].timestamp);
+        }
+        CHECK_EQ(uut.drain([](const trace_event&) {}), 0u);
+      }
+    }
+  }
+}
+
+SCENARIO("trace buffers drop events instead of blocking") {
+  GIVEN("a trace buffer with a capacity of 4") {
+    detail::trace_buffer uut{0, 3};
+    CHECK_EQ(uut.capacity(), 4u);
+    WHEN("pushing more events than fit into the buffer") {
+      THEN("the buffer counts the dropped events") {
+        for (uint64_t i = 1; i <= 6; ++i)
+          uut.push(trace_event_type::steal, i);
+        CHECK_EQ(uut.dropped(), 2u);
+        CHECK_EQ(drain_values(uut), std::vector<uint64_t>({1, 2, 3, 4}));
+      }
+    }
+  }
+}
+
+SCENARIO("trace buffers reuse slots after draining") {
+  GIVEN("a trace buffer with a capacity of 4") {
+    detail::trace_buffer uut{0, 3};
+    WHEN("draining the buffer before it runs full") {
+      THEN("the producer can reuse the slots") {
+        for (uint64_t i = 1; i <= 3; ++i)
+          uut.push(trace_event_type::steal, i);
+        CHECK_EQ(drain_values(uut), std::vector<uint64_t>({1, 2, 3}));
+        for (uint64_t i = 4; i <= 7; ++i)
+          uut.push(trace_event_type::steal, i);
+        CHECK_EQ(uut.dropped(), 0u);
+        CHECK_EQ(drain_values(uut), std::vector<uint64_t>({4, 5, 6, 7}));
+      }
+    }
+  }
+}
+
+SCENARIO("a concurrent consumer receives each event at most once") {
+  GIVEN("a producer thread and a consumer thread") {
+    detail::trace_buffer uut{0, 64};
+    WHEN("the producer pushes events while the consumer drains") {
+      THEN("the consumer observes a strictly increasing sequence") {
+        constexpr uint64_t num_events = 10'000;
+        std::thread producer{[&uut] {
+          for (uint64_t i = 1; i <= num_events; ++i)
+            uut.push(trace_event_type::messages, i);
+        }};
+        uint64_t last = 0;
+        size_t received = 0;
+        auto ordered = true;
+        auto consume = [&](const trace_event& x) {
+          ordered = ordered && x.value > last;
+          last = x.value;
+          ++received;
+        };
+        while (received + uut.dropped() < num_events)
+          uut.drain(consume);
+        producer.join();
+        uut.drain(consume);
+        CHECK(ordered);
+        CHECK_EQ(received + uut.dropped(), num_events);
+      }
+    }
+  }
+}
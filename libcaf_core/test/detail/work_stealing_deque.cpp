@@ -0,0 +1,180 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE detail.work_stealing_deque
+
+#include "caf/detail/work_stealing_deque.hpp"
+
+#include "core-test.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace caf;
+
+namespace {
+
+using int_deque = detail::work_stealing_deque<int>;
+
+struct fixture {
+  fixture() : uut(4) {
+    for (size_t i = 0; i < values.size(); ++i)
+      values[i] = static_cast<int>(i);
+  }
+
+  // Replaces the content of the deque with the first `n` values, starting at
+  // index 1. The steps of a scenario share the fixture, so each step that
+  // modifies the deque needs to start from a known state.
+  void fill(size_t n) {
+    while (uut.pop_bottom() != nullptr)
+      ; // nop
+    for (size_t i = 1; i <= n; ++i)
+      uut.push_bottom(&values[i]);
+  }
+
+  int_deque uut;
+  std::array<int, 1000> values;
+};
+
+} // namespace
+
+BEGIN_FIXTURE_SCOPE(fixture)
+
+SCENARIO("the owner pops elements in LIFO order") {
+  GIVEN("a deque with three elements") {
+    uut.push_bottom(&values[1]);
+    uut.push_bottom(&values[2]);
+    uut.push_bottom(&values[3]);
+    WHEN("calling pop_bottom repeatedly") {
+      THEN("the owner receives the most recent element first") {
+        CHECK_EQ(uut.size_hint(), 3u);
+        CHECK_EQ(uut.pop_bottom(), &values[3]);
+        CHECK_EQ(uut.pop_bottom(), &values[2]);
+        CHECK_EQ(uut.pop_bottom(), &values[1]);
+        CHECK_EQ(uut.pop_bottom(), nullptr);
+        CHECK(uut.empty());
+      }
+    }
+  }
+}
+
+SCENARIO("thieves steal elements in FIFO order") {
+  GIVEN("a deque with three elements") {
+    uut.push_bottom(&values[1]);
+    uut.push_bottom(&values[2]);
+    uut.push_bottom(&values[3]);
+    WHEN("calling steal repeatedly") {
+      THEN("the thief receives the oldest element first") {
+        CHECK_EQ(uut.steal(), &values[1]);
+        CHECK_EQ(uut.steal(), &values[2]);
+        CHECK_EQ(uut.pop_bottom(), &values[3]);
+        CHECK_EQ(uut.steal(), nullptr);
+        CHECK_EQ(uut.pop_bottom(), nullptr);
+      }
+    }
+  }
+}
+
+SCENARIO("the deque grows when running out of capacity") {
+  GIVEN("a deque with an initial capacity of 4") {
+    CHECK_EQ(uut.capacity(), 4u);
+    WHEN("pushing more elements than fit into the circular array") {
+      THEN("the deque doubles its capacity and retains all elements") {
+        uut.push_bottom(&values[0]);
+        CHECK_EQ(uut.steal(), &values[0]);
+        for (size_t i = 1; i <= 10; ++i)
+          uut.push_bottom(&values[i]);
+        CHECK_EQ(uut.capacity(), 16u);
+        CHECK_EQ(uut.size_hint(), 10u);
+        CHECK_EQ(uut.steal(), &values[1]);
+        for (size_t i = 10; i > 1; --i)
+          CHECK_EQ(uut.pop_bottom(), &values[i]);
+        CHECK(uut.empty());
+      }
+    }
+  }
+}
+
+SCENARIO("thieves may steal up to half of the elements at once") {
+  GIVEN("a deque with five elements") {
+    WHEN("calling steal_half") {
+      THEN("the thief receives the oldest elements first") {
+        fill(5);
+        std::vector<int*> stolen;
+        CHECK_EQ(uut.steal_half(10, std::back_inserter(stolen)), 3u);
+        auto expected = std::vector<int*>{&values[1], &values[2], &values[3]};
+        CHECK_EQ(stolen, expected);
+        CHECK_EQ(uut.size_hint(), 2u);
+      }
+    }
+    WHEN("calling steal_half with a small maximum") {
+      THEN("the thief receives no more than the maximum") {
+        fill(5);
+        std::vector<int*> stolen;
+        CHECK_EQ(uut.steal_half(2, std::back_inserter(stolen)), 2u);
+        CHECK_EQ(stolen, std::vector<int*>({&values[1], &values[2]}));
+        CHECK_EQ(uut.pop_bottom(), &values[5]);
+      }
+    }
+  }
+  GIVEN("an empty deque") {
+    WHEN("calling steal_half") {
+      THEN("the thief receives nothing") {
+        fill(0);
+        std::vector<int*> stolen;
+        CHECK_EQ(uut.steal_half(10, std::back_inserter(stolen)), 0u);
+        CHECK(stolen.empty());
+      }
+    }
+  }
+}
+
+SCENARIO("concurrent thieves and the owner never take the same element") {
+  GIVEN("an owner that pushes and pops while three thieves steal") {
+    WHEN("all elements were consumed") {
+      THEN("each element was taken exactly once") {
+        std::atomic<size_t> consumed = 0;
+        std::vector<int*> owner_items;
+        std::array<std::vector<int*>, 3> thief_items;
+        std::vector<std::thread> thieves;
+        for (auto& items : thief_items) {
+          thieves.emplace_back([this, &consumed, &items] {
+            while (consumed.load() < values.size()) {
+              if (auto ptr = uut.steal()) {
+                items.push_back(ptr);
+                ++consumed;
+              }
+            }
+          });
+        }
+        for (size_t i = 0; i < values.size(); ++i) {
+          uut.push_bottom(&values[i]);
+          if (i % 3 == 0) {
+            if (auto ptr = uut.pop_bottom()) {
+              owner_items.push_back(ptr);
+              ++consumed;
+            }
+          }
+        }
+        while (auto ptr = uut.pop_bottom()) {
+          owner_items.push_back(ptr);
+          ++consumed;
+        }
+        for (auto& thief : thieves)
+          thief.join();
+        std::vector<int*> all_items = owner_items;
+        for (auto& items : thief_items)
+          all_items.insert(all_items.end(), items.begin(), items.end());
+        std::sort(all_items.begin(), all_items.end());
+        CHECK_EQ(all_items.size(), values.size());
+        CHECK(std::adjacent_find(all_items.begin(), all_items.end())
+              == all_items.end());
+      }
+    }
+  }
+}
+
+END_FIXTURE_SCOPE()
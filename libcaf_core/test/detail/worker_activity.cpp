@@ -0,0 +1,59 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE detail.worker_activity
+
+#include "caf/detail/worker_activity.hpp"
+
+#include "core-test.hpp"
+
+#include "caf/ref_counted.hpp"
+#include "caf/resumable.hpp"
+
+using namespace caf;
+
+namespace {
+
+struct dummy_job : resumable, ref_counted {
+  resume_result resume(execution_unit*, size_t) override {
+    return resumable::done;
+  }
+
+  void intrusive_ptr_add_ref_impl() override {
+    ref();
+  }
+
+  void intrusive_ptr_release_impl() override {
+    deref();
+  }
+};
+
+} // namespace
+
+SCENARIO("worker activities publish the current job") {
+  GIVEN("an idle worker activity") {
+    detail::worker_activity uut;
+    dummy_job job;
+    WHEN("reading a snapshot") {
+      THEN("the snapshot represents an idle worker") {
+        CHECK_EQ(uut.read().since, 0);
+      }
+    }
+    WHEN("calling begin") {
+      THEN("snapshots contain the start time of the current resume") {
+        auto t0 = detail::worker_activity::now();
+        uut.begin(&job);
+        auto snapshot = uut.read();
+        CHECK_GE(snapshot.since, t0);
+        CHECK_EQ(snapshot.aid, 0u);
+        AND_THEN("each resume has a new sequence number") {
+          uut.end();
+          CHECK_EQ(uut.read().since, 0);
+          uut.begin(&job);
+          CHECK_NE(uut.read().seq, snapshot.seq);
+        }
+      }
+    }
+  }
+}
@@ -15,6 +15,7 @@
 #include <stack>
 
 #include "caf/all.hpp"
+#include "caf/detail/actor_storage_cache.hpp"
 
 using namespace caf;
 
@@ -275,6 +276,40 @@ CAF_TEST(mirror) {
   */
 }
 
+CAF_TEST(spawn_n creates actors with consecutive IDs) {
+  auto running = sys.registry().running();
+  auto mirrors = sys.spawn_n<simple_mirror>(10);
+  CAF_REQUIRE_EQUAL(mirrors.size(), 10u);
+  CHECK_EQ(sys.registry().running(), running + 10);
+  for (size_t i = 1; i < mirrors.size(); ++i)
+    CHECK_EQ(mirrors[i]->id(), mirrors[0]->id() + i);
+  for (auto& mirror : mirrors)
+    self->send(mirror, "hello mirror");
+  run();
+  for (size_t i = 0; i < mirrors.size(); ++i)
+    expect((std::string), from(_).to(self).with("hello mirror"));
+  for (auto& mirror : mirrors)
+    anon_send_exit(mirror, exit_reason::user_shutdown);
+  run();
+  CHECK_EQ(sys.registry().running(), running);
+}
+
+CAF_TEST(new actors reuse the memory of destroyed actors) {
+  auto storage_of = [](const actor& hdl) {
+    return static_cast<void*>(actor_cast<abstract_actor*>(hdl));
+  };
+  auto mirror = sys.spawn<simple_mirror>();
+  auto first = storage_of(mirror);
+  anon_send_exit(mirror, exit_reason::user_shutdown);
+  run();
+  mirror = nullptr;
+  auto next = sys.spawn<simple_mirror>();
+  if constexpr (detail::actor_storage_cache::enabled)
+    CHECK_EQ(storage_of(next), first);
+  anon_send_exit(next, exit_reason::user_shutdown);
+  run();
+}
+
 END_FIXTURE_SCOPE()
 
 BEGIN_FIXTURE_SCOPE(fixture)
@@ -46,6 +46,30 @@ struct inode_policy {
 
 using queue_type = drr_cached_queue<inode_policy>;
 
+// Indexes cached tasks by the parity of their value.
+struct keyed_inode_policy : inode_policy {
+  using cache_key_type = int;
+
+  static inline cache_key_type cache_key(const mapped_type& x) noexcept {
+    return x.value % 2;
+  }
+};
+
+using keyed_queue_type = drr_cached_queue<keyed_inode_policy>;
+
+// Retries only tasks with the key `selected`.
+struct parity_filter {
+  int selected;
+
+  bool retry_all() const noexcept {
+    return false;
+  }
+
+  bool retry(int key) const noexcept {
+    return key == selected;
+  }
+};
+
 struct fixture {
   inode_policy policy;
   queue_type queue{policy};
@@ -223,4 +247,43 @@ CAF_TEST(to_string) {
   CHECK_EQ(deep_to_string(queue.items()), "[1, 2, 3, 4]");
 }
 
+CAF_TEST(flushing_selected_keys) {
+  keyed_queue_type kq{keyed_inode_policy{}};
+  auto skip_all = [](inode&) { return task_result::skip; };
+  fill(kq, 1, 2, 3, 4, 5, 6);
+  CHECK_EQ(kq.new_round(10, skip_all), make_new_round_result(0, false));
+  CHECK_EQ(deep_to_string(kq.cache()), "[1, 2, 3, 4, 5, 6]");
+  MESSAGE("flushing odd tasks keeps even tasks in the cache");
+  parity_filter odd{1};
+  kq.flush_cache_if(odd);
+  CHECK_EQ(deep_to_string(kq.items()), "[1, 3, 5]");
+  CHECK_EQ(deep_to_string(kq.cache()), "[2, 4, 6]");
+  MESSAGE("flushing odd tasks again is a nop");
+  kq.flush_cache_if(odd);
+  CHECK_EQ(deep_to_string(kq.cache()), "[2, 4, 6]");
+  MESSAGE("flushing even tasks moves them in front of the queue");
+  parity_filter even{0};
+  kq.flush_cache_if(even);
+  CHECK_EQ(deep_to_string(kq.items()), "[2, 4, 6, 1, 3, 5]");
+  CHECK(kq.cache().empty());
+}
+
+CAF_TEST(flushing_all_keys) {
+  keyed_queue_type kq{keyed_inode_policy{}};
+  auto skip_all = [](inode&) { return task_result::skip; };
+  fill(kq, 1, 2, 3);
+  kq.new_round(10, skip_all);
+  drr_cache_retry_all all;
+  kq.flush_cache_if(all);
+  CHECK_EQ(deep_to_string(kq.items()), "[1, 2, 3]");
+  CHECK(kq.cache().empty());
+  MESSAGE("tasks that bypass the index force a full flush");
+  kq.new_round(10, skip_all);
+  kq.cache().emplace_back(4);
+  parity_filter odd{1};
+  kq.flush_cache_if(odd);
+  CHECK_EQ(deep_to_string(kq.items()), "[1, 2, 3, 4]");
+  CHECK(kq.cache().empty());
+}
+
 END_FIXTURE_SCOPE()
@@ -114,6 +114,37 @@ CAF_TEST(unblock) {
   CAF_REQUIRE_EQUAL(close_and_fetch(), "01");
 }
 
+CAF_TEST(push_back_chain) {
+  fill(inbox, 1);
+  auto chain = new inode(2);
+  chain->next = new inode(3);
+  chain->next->next = new inode(4);
+  CAF_REQUIRE_EQUAL(inbox.push_back_chain(chain), inbox_result::success);
+  fill(inbox, 5);
+  CAF_REQUIRE_EQUAL(close_and_fetch(), "12345");
+}
+
+CAF_TEST(push_back_chain_unblocks_reader_once) {
+  CAF_REQUIRE_EQUAL(inbox.try_block(), true);
+  auto chain = new inode(1);
+  chain->next = new inode(2);
+  CAF_REQUIRE_EQUAL(inbox.push_back_chain(chain),
+                    inbox_result::unblocked_reader);
+  CAF_REQUIRE_EQUAL(close_and_fetch(), "12");
+}
+
+CAF_TEST(push_back_chain_after_close) {
+  inbox.close();
+  std::unique_ptr<inode> first{new inode(1)};
+  std::unique_ptr<inode> second{new inode(2)};
+  first->next = second.get();
+  auto res = inbox.push_back_chain(first.get());
+  CAF_REQUIRE_EQUAL(res, inbox_result::queue_closed);
+  // The chain remains intact and belongs to the caller.
+  CHECK_EQ(first->next, second.get());
+  CHECK_EQ(second->next, nullptr);
+}
+
 CAF_TEST(await) {
   std::mutex mx;
   std::condition_variable cv;
@@ -137,6 +137,21 @@ CAF_TEST(task_size) {
   CHECK_EQ(queue.total_task_size(), 0);
 }
 
+CAF_TEST(erase_after_if) {
+  auto is_even = [](const inode& x) { return x.value % 2 == 0; };
+  fill(queue, 1, 2, 3, 4);
+  CHECK_EQ(queue.erase_after_if(queue.front(), is_even), 2u);
+  CHECK_EQ(deep_to_string(queue), "[1, 3]");
+  CHECK_EQ(queue.total_task_size(), 4);
+  fill(queue, 5, 6);
+  CHECK_EQ(deep_to_string(queue), "[1, 3, 5, 6]");
+  CHECK_EQ(queue.erase_after_if(nullptr, [](const inode&) { return true; }),
+           4u);
+  CHECK(queue.empty());
+  fill(queue, 7);
+  CHECK_EQ(deep_to_string(queue), "[7]");
+}
+
 CAF_TEST(to_string) {
   CHECK_EQ(deep_to_string(queue), "[]");
   fill(queue, 1, 2, 3, 4);
@@ -71,3 +71,25 @@ CAF_TEST(high_priority) {
                                  no_stages, 42);
   CHECK(m1->mid.category() == message_id::urgent_message_category);
 }
+
+CAF_TEST(fused_payload_outlives_element) {
+  auto m1 = make_mailbox_element(nullptr, make_message_id(), no_stages,
+                                 string{"hello"}, 42);
+  auto msg = m1->content();
+  CHECK(!msg.cptr()->unique());
+  m1.reset();
+  CHECK(msg.cptr()->unique());
+  CHECK_EQ((fetch<string, int>(msg)), make_tuple(string{"hello"}, 42));
+}
+
+CAF_TEST(fused_payload_copy_on_write) {
+  auto m1 = make_mailbox_element(nullptr, make_message_id(), no_stages, 1, 2);
+  auto copy = m1->content();
+  copy.get_mutable_as<int>(0) = 10;
+  CHECK_EQ((fetch<int, int>(*m1)), make_tuple(1, 2));
+  CHECK_EQ((fetch<int, int>(copy)), make_tuple(10, 2));
+  auto forwarded = make_mailbox_element(nullptr, make_message_id(), no_stages,
+                                        std::move(m1->content()));
+  m1.reset();
+  CHECK_EQ((fetch<int, int>(*forwarded)), make_tuple(1, 2));
+}
@@ -67,6 +67,17 @@ CAF_TEST(delayed group message receive responses) {
   expect((std::string), from(testee).to(self).with(hello));
 }
 
+CAF_TEST(batches arrive in order and schedule the receiver once) {
+  run();
+  std::vector<std::string> xs{"a", "b", "c"};
+  self->send_batch(testee, xs);
+  CHECK_EQ(sched.jobs.size(), 1u);
+  for (const auto& x : xs) {
+    expect((std::string), from(self).to(testee).with(x));
+    expect((std::string), from(testee).to(self).with(x));
+  }
+}
+
 CAF_TEST(anonymous messages receive no response) {
   self->anon_send(testee, hello);
   expect((std::string), to(testee).with(hello));
@@ -0,0 +1,213 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE policy.work_sharing
+
+#include "caf/policy/work_sharing.hpp"
+
+#include "core-test.hpp"
+
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/event_based_actor.hpp"
+#include "caf/ref_counted.hpp"
+#include "caf/scoped_actor.hpp"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+using namespace caf;
+
+namespace {
+
+struct fixture {
+  actor_system_config cfg;
+  actor_system sys;
+
+  fixture()
+    : sys(cfg.set("caf.scheduler.max-threads", 4)
+            .set("caf.scheduler.policy", "sharing")) {
+    // nop
+  }
+};
+
+struct dummy_job : resumable, ref_counted {
+  resume_result resume(execution_unit*, size_t) override {
+    return resumable::done;
+  }
+
+  void intrusive_ptr_add_ref_impl() override {
+    ref();
+  }
+
+  void intrusive_ptr_release_impl() override {
+    deref();
+  }
+};
+
+// Provides the interface that the policy expects from a coordinator.
+class fake_coordinator {
+public:
+  explicit fake_coordinator(scheduler::abstract_coordinator* real)
+    : data_(real) {
+    // nop
+  }
+
+  policy::work_sharing::coordinator_data& data() {
+    return data_;
+  }
+
+private:
+  policy::work_sharing::coordinator_data data_;
+};
+
+// Provides the interface that the policy expects from a worker without
+// running a thread. The test calls the policy in place of the worker.
+class fake_worker {
+public:
+  fake_worker(scheduler::abstract_coordinator* real, fake_coordinator* parent)
+    : parent_(parent), data_(real) {
+    // nop
+  }
+
+  size_t id() const {
+    return 0;
+  }
+
+  fake_coordinator* parent() {
+    return parent_;
+  }
+
+  policy::work_sharing::worker_data& data() {
+    return data_;
+  }
+
+  void trace(detail::trace_event_type, uint64_t = 0) {
+    // nop
+  }
+
+private:
+  fake_coordinator* parent_;
+  policy::work_sharing::worker_data data_;
+};
+
+behavior adder() {
+  return {
+    [](int x) { return x + 1; },
+  };
+}
+
+behavior relay(event_based_actor* self, actor next) {
+  return {
+    [self, next](int x) { self->send(next, x + 1); },
+  };
+}
+
+} // namespace
+
+BEGIN_FIXTURE_SCOPE(fixture)
+
+SCENARIO("shards return jobs in FIFO order") {
+  GIVEN("a default-constructed shard") {
+    policy::work_sharing::shard uut;
+    std::array<dummy_job, 200> jobs;
+    WHEN("calling try_pop") {
+      THEN("the shard returns nullptr") {
+        CHECK_EQ(uut.size_hint(), 0u);
+        CHECK_EQ(uut.try_pop(), nullptr);
+      }
+    }
+    WHEN("interleaving push and pop while the ring buffer wraps around") {
+      THEN("the shard grows and returns all jobs in FIFO order") {
+        std::vector<resumable*> popped;
+        // Move the head of the ring buffer away from the front.
+        for (size_t i = 0; i < 40; ++i)
+          uut.push(&jobs[i]);
+        for (size_t i = 0; i < 30; ++i)
+          popped.push_back(uut.try_pop());
+        // Wrap around and grow the ring buffer while popping every third job.
+        for (size_t i = 40; i < 200; ++i) {
+          uut.push(&jobs[i]);
+          if (i % 3 == 0)
+            popped.push_back(uut.try_pop());
+        }
+        CHECK_EQ(uut.size_hint(), 200u - popped.size());
+        while (auto job = uut.try_pop())
+          popped.push_back(job);
+        CHECK_EQ(uut.size_hint(), 0u);
+        if (CHECK_EQ(popped.size(), jobs.size()))
+          for (size_t i = 0; i < jobs.size(); ++i)
+            CHECK_EQ(popped[i], &jobs[i]);
+      }
+    }
+  }
+}
+
+SCENARIO("busy workers periodically check the shards of other workers") {
+  GIVEN("a worker with a backlog in its own shard") {
+    policy::work_sharing uut;
+    fake_coordinator parent{&sys.scheduler()};
+    fake_worker self{&sys.scheduler(), &parent};
+    std::array<dummy_job, 100> own_jobs;
+    dummy_job other_job;
+    auto& shards = parent.data().queue;
+    for (auto& job : own_jobs)
+      shards[0]->push(&job);
+    shards[2]->push(&other_job);
+    WHEN("dequeueing jobs") {
+      THEN("the worker runs the job of the other shard after at most "
+           "fairness_interval jobs") {
+        std::vector<resumable*> popped;
+        for (size_t i = 0; i < policy::work_sharing::fairness_interval; ++i)
+          popped.push_back(uut.dequeue(&self));
+        auto i = std::find(popped.begin(), popped.end(), &other_job);
+        CHECK(i != popped.end());
+        // All other jobs still come in FIFO order.
+        popped.erase(i);
+        for (size_t j = 0; j < popped.size(); ++j)
+          CHECK_EQ(popped[j], &own_jobs[j]);
+      }
+    }
+  }
+}
+
+SCENARIO("the work sharing policy runs all jobs") {
+  GIVEN("an actor system with four workers using work sharing") {
+    WHEN("sending messages to many actors from a non-actor context") {
+      THEN("each actor receives and answers its message") {
+        scoped_actor self{sys};
+        std::vector<actor> workers;
+        for (int i = 0; i < 200; ++i)
+          workers.emplace_back(sys.spawn(adder));
+        for (int i = 0; i < 200; ++i)
+          self->send(workers[static_cast<size_t>(i)], i);
+        int sum = 0;
+        for (size_t i = 0; i < workers.size(); ++i)
+          self->receive([&sum](int x) { sum += x; });
+        CHECK_EQ(sum, 200 * 201 / 2);
+      }
+    }
+    WHEN("actors send messages to each other") {
+      THEN("each message passes the entire chain") {
+        scoped_actor self{sys};
+        auto sink = actor_cast<actor>(self);
+        auto next = sys.spawn(relay, sink);
+        for (int i = 0; i < 50; ++i)
+          next = sys.spawn(relay, next);
+        for (int i = 0; i < 100; ++i)
+          self->send(next, 0);
+        int received = 0;
+        for (int i = 0; i < 100; ++i)
+          self->receive([&received](int x) {
+            if (x == 51)
+              ++received;
+          });
+        CHECK_EQ(received, 100);
+      }
+    }
+  }
+}
+
+END_FIXTURE_SCOPE()
@@ -0,0 +1,338 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE policy.work_stealing
+
+#include "caf/policy/work_stealing.hpp"
+
+#include "core-test.hpp"
+
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/event_based_actor.hpp"
+#include "caf/ref_counted.hpp"
+#include "caf/scoped_actor.hpp"
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace caf;
+
+namespace {
+
+struct fixture {
+  actor_system_config cfg;
+  actor_system sys;
+
+  fixture()
+    : sys(cfg.set("caf.scheduler.max-threads", 2)
+            .set("caf.scheduler.policy", "stealing")
+            .set("caf.work-stealing.aggressive-poll-attempts", 1)
+            .set("caf.work-stealing.moderate-poll-attempts", 1)
+            .set("caf.work-stealing.max-next-slot-runs", 4)) {
+    // nop
+  }
+};
+
+struct dummy_job : resumable, ref_counted {
+  resume_result resume(execution_unit*, size_t) override {
+    return resumable::done;
+  }
+
+  void intrusive_ptr_add_ref_impl() override {
+    ref();
+  }
+
+  void intrusive_ptr_release_impl() override {
+    deref();
+  }
+};
+
+class fake_coordinator;
+
+// Provides the interface that the policy expects from a worker without
+// running a thread. The test calls the policy in place of the worker.
+class fake_worker {
+public:
+  fake_worker(size_t id, fake_coordinator* parent,
+              const policy::work_stealing::worker_data& init)
+    : id_(id), parent_(parent), data_(init) {
+    // nop
+  }
+
+  size_t id() const {
+    return id_;
+  }
+
+  fake_coordinator* parent() {
+    return parent_;
+  }
+
+  policy::work_stealing::worker_data& data() {
+    return data_;
+  }
+
+  void trace(detail::trace_event_type, uint64_t = 0) {
+    // nop
+  }
+
+private:
+  size_t id_;
+  fake_coordinator* parent_;
+  policy::work_stealing::worker_data data_;
+};
+
+// Provides the interface that the policy expects from a coordinator.
+class fake_coordinator {
+public:
+  fake_coordinator(scheduler::abstract_coordinator* real, size_t num)
+    : data_(real) {
+    policy::work_stealing::worker_data init{real};
+    for (size_t id = 0; id < num; ++id)
+      workers_.emplace_back(std::make_unique<fake_worker>(id, this, init));
+  }
+
+  fake_worker* worker_by_id(size_t id) {
+    return workers_[id].get();
+  }
+
+  size_t num_workers() const {
+    return workers_.size();
+  }
+
+  policy::work_stealing::coordinator_data& data() {
+    return data_;
+  }
+
+private:
+  policy::work_stealing::coordinator_data data_;
+  std::vector<std::unique_ptr<fake_worker>> workers_;
+};
+
+// Calls the policy functions on fake workers.
+struct policy_fixture : fixture {
+  policy_fixture() : parent(&sys.scheduler(), 2) {
+    w0 = parent.worker_by_id(0);
+    w1 = parent.worker_by_id(1);
+  }
+
+  static policy::work_stealing::worker_data& d(fake_worker* self) {
+    return self->data();
+  }
+
+  // Blocks until `n` workers have parked.
+  void wait_for_parked_workers(size_t n) {
+    while (parent.data().idle_workers.num_waiters() < n)
+      std::this_thread::yield();
+  }
+
+  fake_coordinator parent;
+  fake_worker* w0;
+  fake_worker* w1;
+  policy::work_stealing uut;
+  dummy_job jobs[8];
+};
+
+behavior adder() {
+  return {
+    [](int x) { return x + 1; },
+  };
+}
+
+// Blocks its worker for `ms` milliseconds before replying to `sink`.
+behavior sleeper(event_based_actor* self) {
+  return {
+    [self](int ms, const actor& sink) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+      self->send(sink, ms);
+    },
+  };
+}
+
+// Sends each message to all `targets`.
+behavior fan_out(event_based_actor* self, std::vector<actor> targets) {
+  return {
+    [self, targets](int ms, const actor& sink) {
+      for (auto& target : targets)
+        self->send(target, ms, sink);
+    },
+  };
+}
+
+// Plays ping-pong with `buddy` until the counter reaches `limit`.
+behavior pinger(event_based_actor* self, actor buddy, actor sink, int limit) {
+  return {
+    [=](int x) {
+      if (x >= limit) {
+        self->send(sink, x);
+        return;
+      }
+      self->request(buddy, infinite, x).then([=](int y) {
+        self->send(self, y);
+      });
+    },
+  };
+}
+
+} // namespace
+
+BEGIN_FIXTURE_SCOPE(fixture)
+
+SCENARIO("the next-to-run slot does not starve other actors") {
+  GIVEN("an actor system with two workers using work stealing") {
+    WHEN("two actors play ping-pong while other actors have messages") {
+      THEN("all actors make progress") {
+        scoped_actor self{sys};
+        auto sink = actor_cast<actor>(self);
+        std::vector<actor> pingers;
+        for (int i = 0; i < 4; ++i)
+          pingers.emplace_back(sys.spawn(pinger, sys.spawn(adder), sink, 500));
+        for (auto& hdl : pingers)
+          self->send(hdl, 0);
+        int finished = 0;
+        for (size_t i = 0; i < pingers.size(); ++i)
+          self->receive([&finished](int x) {
+            if (x == 500)
+              ++finished;
+          });
+        CHECK_EQ(finished, 4);
+      }
+    }
+  }
+}
+
+END_FIXTURE_SCOPE()
+
+SCENARIO("parked workers help with jobs from a fan-out") {
+  GIVEN("an actor system with four parked workers") {
+    actor_system_config cfg;
+    cfg.set("caf.scheduler.max-threads", 4);
+    cfg.set("caf.scheduler.policy", "stealing");
+    actor_system sys{cfg};
+    std::vector<actor> sleepers;
+    for (int i = 0; i < 8; ++i)
+      sleepers.emplace_back(sys.spawn(sleeper));
+    auto source = sys.spawn(fan_out, sleepers);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    WHEN("an actor sends a message to eight actors that block for 50ms") {
+      THEN("the workers process the messages in parallel") {
+        // Running all eight actors on a single worker takes 400ms.
+        scoped_actor self{sys};
+        auto start = std::chrono::steady_clock::now();
+        self->send(source, 50, actor_cast<actor>(self));
+        for (int i = 0; i < 8; ++i)
+          self->receive([](int) {});
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        CHECK_LT(elapsed, std::chrono::milliseconds(300));
+      }
+    }
+  }
+}
+
+BEGIN_FIXTURE_SCOPE(policy_fixture)
+
+SCENARIO("workers run the most recently woken up job next") {
+  GIVEN("an idle worker") {
+    WHEN("the worker schedules two jobs") {
+      THEN("the worker runs the second job first") {
+        uut.internal_enqueue(w0, &jobs[0]);
+        uut.internal_enqueue(w0, &jobs[1]);
+        CHECK_EQ(d(w0).next.load(), &jobs[1]);
+        CHECK_EQ(uut.dequeue(w0), &jobs[1]);
+        CHECK_EQ(uut.dequeue(w0), &jobs[0]);
+        CHECK_EQ(d(w0).next.load(), nullptr);
+      }
+    }
+  }
+}
+
+SCENARIO("other workers cannot steal the job in the next-to-run slot") {
+  GIVEN("a worker with a job in its next-to-run slot") {
+    WHEN("another worker tries to steal from the worker") {
+      THEN("the thief comes back empty-handed") {
+        uut.internal_enqueue(w0, &jobs[0]);
+        CHECK_EQ(uut.steal_from(w1, w0, 1), nullptr);
+        CHECK_EQ(uut.steal_from(w1, w0, 8), nullptr);
+        CHECK_EQ(uut.try_steal(w1, 8), nullptr);
+        CHECK_EQ(uut.dequeue(w0), &jobs[0]);
+      }
+    }
+  }
+}
+
+SCENARIO("the next-to-run slot yields to other jobs after a streak") {
+  GIVEN("a worker with max-next-slot-runs set to 4") {
+    WHEN("the worker runs four jobs in a row from the slot") {
+      THEN("the worker runs its other jobs before the next job in the slot") {
+        uut.internal_enqueue(w0, &jobs[0]);
+        for (size_t i = 1; i <= 4; ++i) {
+          uut.internal_enqueue(w0, &jobs[i]);
+          CHECK_EQ(uut.dequeue(w0), &jobs[i]);
+        }
+        uut.internal_enqueue(w0, &jobs[5]);
+        CHECK_EQ(uut.dequeue(w0), &jobs[0]);
+        CHECK_EQ(uut.dequeue(w0), &jobs[5]);
+        CHECK_EQ(d(w0).next.load(), nullptr);
+      }
+    }
+  }
+}
+
+SCENARIO("stand-ins take over the next-to-run slot of stalled workers") {
+  GIVEN("a stalled worker with a job in its next-to-run slot") {
+    WHEN("a stand-in for the worker looks for jobs") {
+      THEN("the stand-in runs the job from the slot") {
+        fake_worker stand_in{0, &parent, d(w0)};
+        uut.internal_enqueue(w0, &jobs[0]);
+        uut.internal_enqueue(w0, &jobs[1]);
+        CHECK_EQ(uut.try_steal(&stand_in, 8), &jobs[1]);
+        CHECK_EQ(uut.try_steal(&stand_in, 8), &jobs[0]);
+        CHECK_EQ(d(w0).next.load(), nullptr);
+        CHECK_EQ(d(w0).local_queue.size_hint(), 0u);
+      }
+    }
+  }
+}
+
+SCENARIO("enqueueing to a stand-in wakes up the stand-in") {
+  GIVEN("a parked stand-in and another parked worker") {
+    fake_worker stand_in{0, &parent, d(w0)};
+    resumable* result = nullptr;
+    std::thread t1{[this] { uut.dequeue(w1); }};
+    std::thread t2{[this, &stand_in, &result] {
+      result = uut.dequeue(&stand_in);
+    }};
+    wait_for_parked_workers(2);
+    WHEN("a job arrives for the stand-in") {
+      THEN("the stand-in wakes up and runs the job") {
+        uut.external_enqueue(&stand_in, &jobs[0]);
+        t2.join();
+        CHECK_EQ(result, &jobs[0]);
+        uut.external_enqueue(w1, &jobs[1]);
+        t1.join();
+      }
+    }
+  }
+}
+
+SCENARIO("busy workers wake up parked workers to share their jobs") {
+  GIVEN("a parked worker") {
+    resumable* result = nullptr;
+    std::thread t{[this, &result] { result = uut.dequeue(w1); }};
+    wait_for_parked_workers(1);
+    WHEN("another worker schedules more jobs than it runs next") {
+      THEN("the parked worker wakes up and steals a job") {
+        uut.internal_enqueue(w0, &jobs[0]);
+        uut.internal_enqueue(w0, &jobs[1]);
+        t.join();
+        CHECK_EQ(result, &jobs[0]);
+        CHECK_EQ(uut.dequeue(w0), &jobs[1]);
+      }
+    }
+  }
+}
+
+END_FIXTURE_SCOPE()
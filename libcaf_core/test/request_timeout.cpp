@@ -29,6 +29,20 @@ behavior pong(stateful_actor<pong_state>*) {
   };
 }
 
+struct silent_state {
+  static inline const char* name = "silent";
+  std::vector<response_promise> promises;
+};
+
+// never responds to a ping
+behavior silent(stateful_actor<silent_state>* self) {
+  return {
+    [=](ping_atom) {
+      self->state.promises.emplace_back(self->make_response_promise());
+    },
+  };
+}
+
 struct ping_state {
   static inline const char* name = "ping";
   bool had_first_timeout = false; // unused in ping_singleN functions
@@ -208,6 +222,21 @@ behavior ping_multiplexed3(ping_actor* self, bool* had_timeout,
   return {};
 }
 
+// sends many requests, with the later deadlines first
+behavior ping_many(ping_actor* self, size_t* timeouts, const actor& buddy) {
+  for (auto timeout : {milliseconds(200), milliseconds(100)}) {
+    for (size_t i = 0; i < 50; ++i) {
+      self->request(buddy, timeout, ping_atom_v)
+        .then([=](pong_atom) { CAF_FAIL("received pong atom"); },
+              [=](const error& err) {
+                CAF_REQUIRE_EQUAL(err, sec::request_timeout);
+                ++*timeouts;
+              });
+    }
+  }
+  return {};
+}
+
 } // namespace
 
 BEGIN_FIXTURE_SCOPE(test_coordinator_fixture<>)
@@ -284,4 +313,29 @@ CAF_TEST(multiplexed_timeout) {
   }
 }
 
+CAF_TEST(request_timeouts_share_a_clock_entry) {
+  size_t timeouts = 0;
+  auto buddy = sys.spawn(silent);
+  auto testee = sys.spawn(ping_many, &timeouts, buddy);
+  sched.run();
+  auto& actions = sched.clock().actions;
+  auto pending = [&actions] {
+    auto active = [](const auto& kvp) { return !kvp.second.disposed(); };
+    return std::count_if(actions.begin(), actions.end(), active);
+  };
+  CHECK_EQ(pending(), 1);
+  MESSAGE("the earliest deadline expires all requests with that deadline");
+  sched.advance_time(milliseconds(100));
+  sched.run();
+  CHECK_EQ(timeouts, 50u);
+  CHECK_EQ(pending(), 1);
+  MESSAGE("the clock entry moves on to the next deadline");
+  sched.advance_time(milliseconds(100));
+  sched.run();
+  CHECK_EQ(timeouts, 100u);
+  CHECK_EQ(pending(), 0);
+  // The promises of the silent actor keep it alive until we kill it.
+  anon_send_exit(buddy, exit_reason::kill);
+}
+
 END_FIXTURE_SCOPE()
@@ -8,6 +8,13 @@
 
 #include "core-test.hpp"
 
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/scoped_actor.hpp"
+
+#include <chrono>
+#include <thread>
+
 using namespace caf;
 
 #define ASSERT_COMPILES(expr, msg)                                             \
@@ -140,4 +147,133 @@ ASSERT_COMPILES(set_exception_handler(const_exception_fn{}),
 
 #endif // CAF_ENABLE_EXCEPTIONS
 
+// -- actors for testing the cache of skipped messages -------------------------
+
+struct stash_state {
+  static inline const char* name = "stash";
+  std::vector<int> received;
+  bool got_down = false;
+};
+
+using stash_actor = stateful_actor<stash_state>;
+
+behavior stash_closed(stash_actor* self);
+
+behavior stash_open(stash_actor* self) {
+  return {
+    [self](int x) { self->state.received.push_back(x); },
+    [self](close_atom) { self->become(stash_closed(self)); },
+  };
+}
+
+behavior stash_closed(stash_actor* self) {
+  return {
+    [self](open_atom) { self->become(stash_open(self)); },
+  };
+}
+
+behavior stash(stash_actor* self) {
+  self->set_default_handler(skip);
+  return stash_closed(self);
+}
+
 } // namespace
+
+SCENARIO("actors yield after exceeding the maximum run time") {
+  GIVEN("an actor system with a single worker and a maximum run time") {
+    actor_system_config cfg;
+    cfg.set("caf.scheduler.max-threads", 1);
+    cfg.set("caf.scheduler.max-run-time", timespan{1'000'000});
+    actor_system sys{cfg};
+    WHEN("an actor receives many messages with expensive handlers") {
+      THEN("the actor yields before draining its mailbox") {
+        auto slow = sys.spawn([]() -> behavior {
+          return {
+            [](int x) {
+              std::this_thread::sleep_for(std::chrono::milliseconds(2));
+              return x;
+            },
+          };
+        });
+        scoped_actor self{sys};
+        for (int i = 0; i < 16; ++i)
+          self->send(slow, i);
+        int sum = 0;
+        for (int i = 0; i < 16; ++i)
+          self->receive([&sum](int x) { sum += x; });
+        CHECK_EQ(sum, 120);
+        CHECK_GT(sys.base_metrics().max_run_time_yields->value(), 0);
+        CHECK_EQ(sys.base_metrics().max_throughput_yields->value(), 0);
+      }
+    }
+  }
+}
+
+BEGIN_FIXTURE_SCOPE(test_coordinator_fixture<>)
+
+SCENARIO("actors retry skipped messages once their behavior accepts them") {
+  GIVEN("an actor that uses skip as its default handler") {
+    auto aut = sys.spawn(stash);
+    auto& st = deref<stash_actor>(aut).state;
+    run();
+    WHEN("the actor receives messages that it cannot handle yet") {
+      THEN("the actor processes them in order after changing its behavior") {
+        for (int i = 1; i <= 3; ++i)
+          self->send(aut, i);
+        self->send(aut, "hello world");
+        run();
+        CHECK(st.received.empty());
+        self->send(aut, open_atom_v);
+        self->send(aut, 4);
+        self->send(aut, close_atom_v);
+        self->send(aut, 5);
+        run();
+        CHECK_EQ(st.received, std::vector<int>({1, 2, 3, 4}));
+        self->send(aut, open_atom_v);
+        run();
+        CHECK_EQ(st.received, std::vector<int>({1, 2, 3, 4, 5}));
+      }
+    }
+  }
+  GIVEN("an actor that uses skip as its default handler and awaits") {
+    auto worker = sys.spawn([]() -> behavior {
+      return {
+        [](int) {},
+      };
+    });
+    auto server = sys.spawn<lazy_init>([]() -> behavior {
+      return {
+        [](get_atom) { return 42; },
+      };
+    });
+    auto aut = sys.spawn([worker, server](stash_actor* self) {
+      self->set_default_handler(skip);
+      self->set_down_handler(
+        [self](down_msg&) { self->state.got_down = true; });
+      self->monitor(worker);
+      self->request(server, infinite, get_atom_v).await([self](int x) {
+        self->state.received.push_back(x);
+      });
+      return stash_closed(self);
+    });
+    auto& st = deref<stash_actor>(aut).state;
+    // Only run the actor itself to keep the server from responding.
+    sched.prioritize(aut);
+    sched.run_once();
+    WHEN("a system message arrives before the awaited response") {
+      THEN("the actor handles it after receiving the response") {
+        anon_send_exit(worker, exit_reason::user_shutdown);
+        sched.prioritize(worker);
+        sched.run_once();
+        sched.prioritize(aut);
+        sched.run_once();
+        CHECK(!st.got_down);
+        run();
+        CHECK_EQ(st.received, std::vector<int>({42}));
+        CHECK(st.got_down);
+      }
+    }
+  }
+}
+
+END_FIXTURE_SCOPE()
@@ -0,0 +1,292 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE scheduler.coordinator
+
+#include "caf/scheduler/coordinator.hpp"
+
+#include "core-test.hpp"
+
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/event_based_actor.hpp"
+#include "caf/scoped_actor.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+
+using namespace caf;
+
+namespace {
+
+// Adds the pools 'gateway' and 'batch' to `cfg`. There are no config options
+// for the pools, since users pick the names. Hence, `cfg.set` rejects them.
+actor_system_config& add_pools(actor_system_config& cfg) {
+  cfg.set("caf.scheduler.max-threads", 2);
+  put(cfg.content, "caf.scheduler.pools.gateway.max-threads", 1);
+  put(cfg.content, "caf.scheduler.pools.gateway.policy", "sharing");
+  put(cfg.content, "caf.scheduler.pools.batch.max-threads", 3);
+  return cfg;
+}
+
+struct fixture {
+  actor_system_config cfg;
+  actor_system sys;
+
+  fixture() : sys(add_pools(cfg)) {
+    // nop
+  }
+};
+
+// Replies whether the actor runs on a worker of `pool`.
+behavior pool_checker(event_based_actor* self,
+                      scheduler::abstract_coordinator* pool) {
+  return {
+    [self, pool](int) { return self->context()->pool() == pool; },
+  };
+}
+
+// Forwards each message to `next` after checking the pool.
+behavior pool_relay(event_based_actor* self,
+                    scheduler::abstract_coordinator* pool, actor next) {
+  return {
+    [self, pool, next](int x) {
+      if (self->context()->pool() == pool)
+        self->send(next, x + 1);
+    },
+  };
+}
+
+// Blocks the worker for the given number of milliseconds.
+behavior sleeper() {
+  return {
+    [](int ms) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+      return std::string{"sleeper"};
+    },
+  };
+}
+
+behavior responder() {
+  return {
+    [](int) { return std::string{"responder"}; },
+  };
+}
+
+} // namespace
+
+SCENARIO("the watchdog reports workers that stall in a single job") {
+  GIVEN("a scheduler with a stall threshold of 10ms") {
+    actor_system_config cfg;
+    cfg.set("caf.scheduler.max-threads", 1);
+    cfg.set("caf.scheduler.stall-threshold", timespan{10'000'000});
+    actor_system sys{cfg};
+    WHEN("an actor blocks its worker for longer than the threshold") {
+      THEN("the watchdog increments the stall counter") {
+        scoped_actor self{sys};
+        self->send(sys.spawn(sleeper), 100);
+        self->receive([](const std::string&) {});
+        auto stalls = sys.metrics().counter_instance(
+          "caf.scheduler", "stalls", {{"pool", "default"}},
+          "Number of jobs that ran longer than the stall threshold.", "1",
+          true);
+        CHECK_EQ(stalls->value(), 1);
+      }
+    }
+  }
+  GIVEN("a scheduler with one worker that replaces stalled workers") {
+    actor_system_config cfg;
+    cfg.set("caf.scheduler.max-threads", 1);
+    cfg.set("caf.scheduler.stall-threshold", timespan{10'000'000});
+    cfg.set("caf.scheduler.replace-stalled-workers", true);
+    actor_system sys{cfg};
+    WHEN("an actor blocks the only worker") {
+      THEN("a stand-in worker runs the other actors in the meantime") {
+        scoped_actor self{sys};
+        auto sleepy = sys.spawn(sleeper);
+        auto responsive = sys.spawn(responder);
+        self->send(sleepy, 500);
+        self->send(responsive, 0);
+        std::vector<std::string> replies;
+        for (int i = 0; i < 2; ++i)
+          self->receive([&replies](std::string& x) {
+            replies.emplace_back(std::move(x));
+          });
+        CHECK_EQ(replies,
+                 std::vector<std::string>({"responder", "sleeper"}));
+      }
+    }
+  }
+  GIVEN("schedulers with four workers that replace stalled workers") {
+    for (auto policy : {"stealing", "sharing"}) {
+      actor_system_config cfg;
+      cfg.set("caf.scheduler.policy", policy);
+      cfg.set("caf.scheduler.max-threads", 4);
+      cfg.set("caf.scheduler.stall-threshold", timespan{10'000'000});
+      cfg.set("caf.scheduler.replace-stalled-workers", true);
+      WHEN("an actor blocks a worker until the system shuts down") {
+        THEN("the system retires the stand-in and shuts down") {
+          MESSAGE("policy: " << policy);
+          int64_t stalls = 0;
+          {
+            actor_system sys{cfg};
+            scoped_actor self{sys};
+            self->send(sys.spawn(sleeper), 200);
+            self->receive([](const std::string&) {});
+            stalls = sys.metrics()
+                       .counter_instance("caf.scheduler", "stalls",
+                                         {{"pool", "default"}},
+                                         "Number of jobs that ran longer than "
+                                         "the stall threshold.",
+                                         "1", true)
+                       ->value();
+          }
+          CHECK_GE(stalls, 1);
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("workers write a trace of their activity if configured") {
+  GIVEN("a scheduler with a trace file") {
+    auto path = std::string{"caf-scheduler-coordinator-trace.json"};
+    actor_system_config cfg;
+    cfg.set("caf.scheduler.max-threads", 2);
+    cfg.set("caf.scheduler.trace-file", path);
+    WHEN("actors process messages") {
+      THEN("the trace file contains the resumes of the actors") {
+        {
+          actor_system sys{cfg};
+          scoped_actor self{sys};
+          auto worker = sys.spawn(responder);
+          for (int i = 0; i < 10; ++i)
+            self->request(worker, infinite, i)
+              .receive([](const std::string&) {},
+                       [](const error& err) { FAIL("error: " << err); });
+        }
+        std::ifstream in{path};
+        std::string content{std::istreambuf_iterator<char>{in},
+                            std::istreambuf_iterator<char>{}};
+        in.close();
+        std::remove(path.c_str());
+        CHECK_EQ(content.compare(0, 16, R"({"traceEvents":[)"), 0);
+        CHECK_NE(content.find(R"("name":"caf.scheduler.default")"),
+                 std::string::npos);
+        CHECK_NE(content.find(R"("name":"caf.worker.1")"), std::string::npos);
+        CHECK_NE(content.find(R"("cat":"resume","ph":"B")"),
+                 std::string::npos);
+        CHECK_NE(content.find(R"("args":{"messages":1})"), std::string::npos);
+        CHECK_NE(content.find(R"("droppedEvents":"0")"), std::string::npos);
+      }
+    }
+  }
+  GIVEN("a scheduler pool with quotes in its name") {
+    auto default_path = std::string{"caf-scheduler-coordinator-default.json"};
+    auto path = std::string{"caf-scheduler-coordinator-quotes.json"};
+    actor_system_config cfg;
+    cfg.set("caf.scheduler.max-threads", 1);
+    cfg.set("caf.scheduler.trace-file", default_path);
+    put(cfg.content, R"(caf.scheduler.pools.say "hi".max-threads)", 1);
+    put(cfg.content, R"(caf.scheduler.pools.say "hi".trace-file)", path);
+    WHEN("the pool writes its trace") {
+      THEN("the trace file escapes the name of the pool") {
+        {
+          actor_system sys{cfg};
+          REQUIRE_NE(sys.scheduler_pool(R"(say "hi")"), nullptr);
+        }
+        std::ifstream in{path};
+        std::string content{std::istreambuf_iterator<char>{in},
+                            std::istreambuf_iterator<char>{}};
+        in.close();
+        std::remove(path.c_str());
+        std::remove(default_path.c_str());
+        CHECK_NE(content.find(R"("name":"caf.scheduler.say \"hi\"")"),
+                 std::string::npos);
+      }
+    }
+  }
+}
+
+BEGIN_FIXTURE_SCOPE(fixture)
+
+SCENARIO("actor systems create named scheduler pools from the config") {
+  GIVEN("an actor system with the pools 'gateway' and 'batch'") {
+    WHEN("looking up the pools by name") {
+      THEN("each pool uses its own number of workers") {
+        auto gateway = sys.scheduler_pool("gateway");
+        auto batch = sys.scheduler_pool("batch");
+        if (CHECK(gateway != nullptr) && CHECK(batch != nullptr)) {
+          CHECK_EQ(gateway->pool_name(), "gateway");
+          CHECK_EQ(gateway->num_workers(), 1u);
+          CHECK_EQ(batch->pool_name(), "batch");
+          CHECK_EQ(batch->num_workers(), 3u);
+        }
+        CHECK_EQ(sys.scheduler().num_workers(), 2u);
+        CHECK(sys.scheduler().is_default_pool());
+        CHECK_EQ(sys.scheduler_pool("default"), nullptr);
+        CHECK_EQ(sys.scheduler_pool("foo"), nullptr);
+      }
+    }
+  }
+}
+
+SCENARIO("actors spawned in a pool run on the workers of that pool") {
+  GIVEN("an actor system with the pools 'gateway' and 'batch'") {
+    auto gateway = sys.scheduler_pool("gateway");
+    auto batch = sys.scheduler_pool("batch");
+    REQUIRE_NE(gateway, nullptr);
+    REQUIRE_NE(batch, nullptr);
+    WHEN("spawning actors in different pools") {
+      THEN("each actor only runs on workers of its own pool") {
+        scoped_actor self{sys};
+        auto check = [&](const actor& hdl) {
+          auto result = false;
+          self->request(hdl, infinite, 42)
+            .receive([&result](bool x) { result = x; },
+                     [](const error& err) { FAIL("unexpected: " << err); });
+          return result;
+        };
+        CHECK(check(sys.spawn_in_pool("gateway", pool_checker, gateway)));
+        CHECK(check(sys.spawn_in_pool("batch", pool_checker, batch)));
+        CHECK(check(sys.spawn(pool_checker, nullptr)));
+        CHECK(check(sys.spawn_in_pool("default", pool_checker, nullptr)));
+      }
+    }
+#ifdef CAF_ENABLE_EXCEPTIONS
+    WHEN("spawning an actor in an unknown pool") {
+      THEN("the actor system refuses to spawn the actor") {
+        CHECK_THROWS_AS(sys.spawn_in_pool("foo", pool_checker, nullptr),
+                        std::invalid_argument);
+      }
+    }
+#endif // CAF_ENABLE_EXCEPTIONS
+    WHEN("actors in different pools send messages to each other") {
+      THEN("each message crosses into the pool of the receiver") {
+        scoped_actor self{sys};
+        auto next = actor_cast<actor>(self);
+        for (int i = 0; i < 10; ++i) {
+          next = sys.spawn_in_pool("gateway", pool_relay, gateway, next);
+          next = sys.spawn(pool_relay, nullptr, next);
+          next = sys.spawn_in_pool("batch", pool_relay, batch, next);
+        }
+        for (int i = 0; i < 10; ++i)
+          self->send(next, 0);
+        int received = 0;
+        for (int i = 0; i < 10; ++i)
+          self->receive([&received](int x) {
+            if (x == 30)
+              ++received;
+          });
+        CHECK_EQ(received, 10);
+      }
+    }
+  }
+}
+
+END_FIXTURE_SCOPE()
@@ -299,3 +299,31 @@ CAF_TEST(enabling actor metrics per config creates metric instances) {
   CHECK_CONTAINS(R"(caf.actor.mailbox-size{name="caf.system.spawn-server"})");
   CHECK_CONTAINS(R"(caf.actor.mailbox-size{name="caf.system.config-server"})");
 }
+
+CAF_TEST(actors sample metrics with the rate of the longest matching pattern) {
+  actor_system_config cfg;
+  test_coordinator_fixture<>::init_config(cfg);
+  put(cfg.content, "caf.metrics-filters.actors.includes",
+      std::vector<std::string>{"user.*"});
+  settings rates;
+  rates["*"] = config_value{100};
+  rates["user.*"] = config_value{4};
+  put(cfg.content, "caf.metrics-filters.actors.sample-rates", rates);
+  actor_system sys{cfg};
+  auto& sched = dynamic_cast<scheduler::test_coordinator&>(sys.scheduler());
+  auto aut = sys.spawn([]() -> behavior { return {[](int) {}}; });
+  auto& metrics = static_cast<local_actor*>(actor_cast<abstract_actor*>(aut))
+                    ->builtin_metrics();
+  CHECK_EQ(metrics.sample_rate, 4u);
+  sched.run();
+  for (int i = 0; i < 1000; ++i)
+    anon_send(aut, i);
+  sched.run();
+  int64_t samples = 0;
+  for (auto& bucket : metrics.mailbox_time->buckets())
+    samples += bucket.count.value();
+  MESSAGE("sampled " << samples << " out of 1000 messages");
+  CHECK_GT(samples, 0);
+  CHECK_LT(samples, 500);
+  CHECK_EQ(metrics.mailbox_size->value(), 0);
+}
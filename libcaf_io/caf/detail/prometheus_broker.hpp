@@ -14,6 +14,7 @@
 #include "caf/io/broker.hpp"
 #include "caf/telemetry/collector/prometheus.hpp"
 #include "caf/telemetry/importer/process.hpp"
+#include "caf/telemetry/importer/slab_allocator.hpp"
 
 namespace caf::detail {
 
@@ -41,6 +42,7 @@ private:
   telemetry::collector::prometheus collector_;
   time_t last_scrape_ = 0;
   telemetry::importer::process proc_importer_;
+  telemetry::importer::slab_allocator alloc_importer_;
 };
 
 } // namespace caf::detail
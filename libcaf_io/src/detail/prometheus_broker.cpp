@@ -36,7 +36,9 @@ constexpr std::string_view request_ok = "HTTP/1.1 200 OK\r\n"
 } // namespace
 
 prometheus_broker::prometheus_broker(actor_config& cfg)
-  : io::broker(cfg), proc_importer_(system().metrics()) {
+  : io::broker(cfg),
+    proc_importer_(system().metrics()),
+    alloc_importer_(system().metrics()) {
   // nop
 }
 
@@ -117,6 +119,7 @@ void prometheus_broker::scrape() {
   if (last_scrape_ < now) {
     last_scrape_ = now;
     proc_importer_.update();
+    alloc_importer_.update();
   }
 }
 
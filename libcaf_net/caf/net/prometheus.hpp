@@ -10,6 +10,7 @@
 #include "caf/net/http/responder.hpp"
 #include "caf/telemetry/collector/prometheus.hpp"
 #include "caf/telemetry/importer/process.hpp"
+#include "caf/telemetry/importer/slab_allocator.hpp"
 
 #include <chrono>
 #include <memory>
@@ -31,7 +32,8 @@ public:
     : registry(ptr),
       last_scrape(duration{0}),
       proc_import_interval(proc_import_interval),
-      proc_importer(*ptr) {
+      proc_importer(*ptr),
+      alloc_importer(*ptr) {
     // nop
   }
 
@@ -39,6 +41,7 @@ public:
   std::chrono::steady_clock::time_point last_scrape;
   timespan proc_import_interval;
   telemetry::importer::process proc_importer;
+  telemetry::importer::slab_allocator alloc_importer;
   telemetry::collector::prometheus collector;
 };
 
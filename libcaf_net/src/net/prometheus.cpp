@@ -16,6 +16,7 @@ std::string_view scrape_state::scrape() {
       last_scrape + proc_import_interval <= now) {
     last_scrape = now;
     proc_importer.update();
+    alloc_importer.update();
   }
   return collector.collect_from(*registry);
 }
@@ -0,0 +1,687 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+// Micro-benchmarks for scheduler and runtime internals. Run `caf-bench -b
+// <name>` to select a benchmark or `caf-bench` to run all benchmarks.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "caf/all.hpp"
+#include "caf/detail/double_ended_queue.hpp"
+#include "caf/detail/slab_allocator.hpp"
+#include "caf/detail/work_stealing_deque.hpp"
+#include "caf/policy/work_sharing.hpp"
+
+using namespace caf;
+
+namespace {
+
+using bench_clock = std::chrono::steady_clock;
+
+struct config : actor_system_config {
+  config() {
+    opt_group{custom_options_, "global"}
+      .add(benchmark, "benchmark,b", "selects a benchmark (default: all)")
+      .add(iterations, "iterations,i", "sets the number of operations")
+      .add(thieves, "thieves,t", "sets the number of stealing threads")
+      .add(producers, "producers,p", "sets the number of producer threads")
+      .add(fan_out_jobs, "fan-out-jobs", "sets the number of fan-out jobs")
+      .add(job_duration, "job-duration", "sets how long fan-out jobs block");
+  }
+
+  std::string benchmark;
+  size_t iterations = 1'000'000;
+  size_t thieves = 2;
+  size_t producers = 4;
+  size_t fan_out_jobs = 64;
+  timespan job_duration = timespan{10'000'000};
+};
+
+// Prints the average time per operation.
+void report(const std::string& name, bench_clock::duration elapsed,
+            size_t operations) {
+  using std::chrono::duration_cast;
+  using std::chrono::nanoseconds;
+  auto ns = static_cast<double>(duration_cast<nanoseconds>(elapsed).count());
+  std::cout << std::left << std::setw(48) << name << std::right << std::fixed
+            << std::setprecision(2) << std::setw(10) << ns / operations
+            << " ns/op" << std::endl;
+}
+
+// -- deque: local queue of work-stealing workers ------------------------------
+
+// Adapts the queues to a common interface.
+template <class Queue>
+struct deque_ops;
+
+template <class T>
+struct deque_ops<detail::work_stealing_deque<T>> {
+  static constexpr const char* name = "work_stealing_deque";
+
+  static void push(detail::work_stealing_deque<T>& q, T* x) {
+    q.push_bottom(x);
+  }
+
+  static T* pop(detail::work_stealing_deque<T>& q) {
+    return q.pop_bottom();
+  }
+
+  static T* steal(detail::work_stealing_deque<T>& q) {
+    return q.steal();
+  }
+};
+
+template <class T>
+struct deque_ops<detail::double_ended_queue<T>> {
+  static constexpr const char* name = "double_ended_queue";
+
+  static void push(detail::double_ended_queue<T>& q, T* x) {
+    q.prepend(x);
+  }
+
+  static T* pop(detail::double_ended_queue<T>& q) {
+    return q.try_take_head();
+  }
+
+  static T* steal(detail::double_ended_queue<T>& q) {
+    return q.try_take_tail();
+  }
+};
+
+// Lets the owner push and pop bursts of jobs without any thieves.
+template <class Queue>
+void deque_owner(const config& cfg) {
+  using ops = deque_ops<Queue>;
+  constexpr size_t burst = 64;
+  Queue q;
+  int dummy = 0;
+  auto rounds = std::max(cfg.iterations / burst, size_t{1});
+  auto start = bench_clock::now();
+  for (size_t round = 0; round < rounds; ++round) {
+    for (size_t i = 0; i < burst; ++i)
+      ops::push(q, &dummy);
+    for (size_t i = 0; i < burst; ++i)
+      ops::pop(q);
+  }
+  report(std::string{"deque/owner/"} + ops::name, bench_clock::now() - start,
+         rounds * burst * 2);
+}
+
+// Lets the owner push and pop jobs while other threads steal from the queue.
+template <class Queue>
+void deque_contended(const config& cfg) {
+  using ops = deque_ops<Queue>;
+  Queue q;
+  int dummy = 0;
+  std::atomic<bool> done = false;
+  std::vector<std::thread> thieves;
+  for (size_t i = 0; i < cfg.thieves; ++i)
+    thieves.emplace_back([&] {
+      while (!done.load(std::memory_order_relaxed))
+        if (ops::steal(q) == nullptr)
+          std::this_thread::yield();
+    });
+  auto start = bench_clock::now();
+  for (size_t i = 0; i < cfg.iterations; ++i) {
+    ops::push(q, &dummy);
+    if (i % 2 == 0)
+      ops::pop(q);
+  }
+  while (ops::pop(q) != nullptr)
+    ; // nop
+  auto elapsed = bench_clock::now() - start;
+  done = true;
+  for (auto& t : thieves)
+    t.join();
+  report(std::string{"deque/contended/"} + ops::name, elapsed, cfg.iterations);
+}
+
+void deque(actor_system&, const config& cfg) {
+  deque_owner<detail::work_stealing_deque<int>>(cfg);
+  deque_owner<detail::double_ended_queue<int>>(cfg);
+  deque_contended<detail::work_stealing_deque<int>>(cfg);
+  deque_contended<detail::double_ended_queue<int>>(cfg);
+}
+
+// -- shards: central queue of the work-sharing policy -------------------------
+
+// Runs `producers` threads that each enqueue and dequeue jobs, either on a
+// single shard or on one shard per thread.
+void shards_run(const config& cfg, size_t num_shards) {
+  using shard = policy::work_sharing::shard;
+  std::vector<std::unique_ptr<shard>> shards;
+  for (size_t i = 0; i < num_shards; ++i)
+    shards.emplace_back(std::make_unique<shard>());
+  auto per_thread = std::max(cfg.iterations / cfg.producers, size_t{1});
+  std::vector<std::thread> threads;
+  auto start = bench_clock::now();
+  for (size_t id = 0; id < cfg.producers; ++id)
+    threads.emplace_back([&, id] {
+      auto& q = *shards[id % num_shards];
+      for (size_t i = 0; i < per_thread; ++i) {
+        // The shard never dereferences its jobs.
+        q.push(nullptr);
+        q.try_pop();
+      }
+    });
+  for (auto& t : threads)
+    t.join();
+  auto name = "shards/" + std::to_string(cfg.producers) + "-producers/"
+              + std::to_string(num_shards) + "-shards";
+  report(name, bench_clock::now() - start, per_thread * cfg.producers * 2);
+}
+
+void shards(actor_system&, const config& cfg) {
+  shards_run(cfg, 1);
+  shards_run(cfg, cfg.producers);
+}
+
+// -- fan-out: balancing a burst of jobs across workers ------------------------
+
+// Blocks its worker for the given time before replying to `sink`.
+behavior blocking_job(event_based_actor* self) {
+  return {
+    [self](timespan duration, const actor& sink) {
+      std::this_thread::sleep_for(duration);
+      self->send(sink, duration);
+    },
+  };
+}
+
+// Sends each message to all `targets`.
+behavior fan_out_source(event_based_actor* self, std::vector<actor> targets) {
+  return {
+    [self, targets](timespan duration, const actor& sink) {
+      for (auto& target : targets)
+        self->send(target, duration, sink);
+    },
+  };
+}
+
+// Lets a single actor make many actors runnable at once after all workers
+// went idle and measures how long the workers need to run all of them.
+void fan_out(actor_system& sys, const config& cfg) {
+  using std::chrono::duration_cast;
+  using std::chrono::milliseconds;
+  std::vector<actor> targets;
+  for (size_t i = 0; i < cfg.fan_out_jobs; ++i)
+    targets.emplace_back(sys.spawn(blocking_job));
+  auto source = sys.spawn(fan_out_source, targets);
+  // Give the workers enough time to stop polling and park.
+  std::this_thread::sleep_for(milliseconds(500));
+  scoped_actor self{sys};
+  auto start = bench_clock::now();
+  self->send(source, cfg.job_duration, actor_cast<actor>(self));
+  for (size_t i = 0; i < cfg.fan_out_jobs; ++i)
+    self->receive([](timespan) {});
+  auto elapsed = bench_clock::now() - start;
+  auto workers = sys.scheduler().num_workers();
+  auto rounds = (cfg.fan_out_jobs + workers - 1) / workers;
+  std::cout << std::left << std::setw(48) << "fan-out/time-to-completion"
+            << std::right << std::setw(10)
+            << duration_cast<milliseconds>(elapsed).count() << " ms (ideal: "
+            << duration_cast<milliseconds>(cfg.job_duration * rounds).count()
+            << " ms with " << workers << " workers)" << std::endl;
+}
+
+// -- allocations: pools for mailbox elements and message data -----------------
+
+// Prints how many allocations since `before` hit the thread-local pools.
+void report_pools(const std::string& name,
+                  const detail::slab_allocator::statistics& before) {
+  auto after = detail::slab_allocator::stats();
+  auto hits = after.hits - before.hits;
+  auto total = hits + after.misses - before.misses + after.heap_allocations
+               - before.heap_allocations;
+  std::cout << std::left << std::setw(48) << name << std::right << std::fixed
+            << std::setprecision(2) << std::setw(10)
+            << (total > 0 ? 100.0 * hits / total : 0.0) << " % hits ("
+            << total << " allocations)" << std::endl;
+}
+
+// Creates and destroys mailbox elements on the same thread.
+void allocations_local(const config& cfg) {
+  auto before = detail::slab_allocator::stats();
+  auto start = bench_clock::now();
+  for (size_t i = 0; i < cfg.iterations; ++i)
+    make_mailbox_element(nullptr, make_message_id(), {}, int32_t{42});
+  report("allocations/local", bench_clock::now() - start, cfg.iterations);
+  report_pools("allocations/local/pools", before);
+}
+
+// Creates mailbox elements on one thread and destroys them on another thread,
+// like actors that send messages to actors on other workers.
+void allocations_remote(const config& cfg) {
+  constexpr size_t burst = 256;
+  auto rounds = std::max(cfg.iterations / burst, size_t{1});
+  auto before = detail::slab_allocator::stats();
+  std::vector<mailbox_element_ptr> elements;
+  std::mutex mtx;
+  std::condition_variable cv;
+  bool ready = false;
+  bool done = false;
+  std::thread consumer{[&] {
+    std::unique_lock guard{mtx};
+    for (;;) {
+      cv.wait(guard, [&] { return ready || done; });
+      if (!ready)
+        return;
+      elements.clear();
+      ready = false;
+      cv.notify_all();
+    }
+  }};
+  auto start = bench_clock::now();
+  for (size_t round = 0; round < rounds; ++round) {
+    std::vector<mailbox_element_ptr> buf;
+    for (size_t i = 0; i < burst; ++i)
+      buf.emplace_back(
+        make_mailbox_element(nullptr, make_message_id(), {}, int32_t{42}));
+    std::unique_lock guard{mtx};
+    cv.wait(guard, [&] { return !ready; });
+    elements = std::move(buf);
+    ready = true;
+    cv.notify_all();
+  }
+  {
+    std::unique_lock guard{mtx};
+    cv.wait(guard, [&] { return !ready; });
+    done = true;
+    cv.notify_all();
+  }
+  consumer.join();
+  report("allocations/remote", bench_clock::now() - start, rounds * burst);
+  report_pools("allocations/remote/pools", before);
+}
+
+// Compares mailbox elements that share a block with their payload to
+// elements that allocate the payload separately.
+void allocations_fused(const config& cfg) {
+  auto run = [&cfg](const char* name, auto make) {
+    int64_t sum = 0;
+    auto start = bench_clock::now();
+    for (size_t i = 0; i < cfg.iterations; ++i) {
+      auto elem = make(static_cast<int32_t>(i));
+      sum += elem->payload.template get_as<int32_t>(0);
+    }
+    report(name, bench_clock::now() - start, cfg.iterations);
+    return sum;
+  };
+  run("allocations/two-blocks", [](int32_t x) {
+    return make_mailbox_element(nullptr, make_message_id(), {},
+                                make_message(x));
+  });
+  run("allocations/fused", [](int32_t x) {
+    return make_mailbox_element(nullptr, make_message_id(), {}, x);
+  });
+}
+
+void allocations(actor_system&, const config& cfg) {
+  allocations_local(cfg);
+  allocations_remote(cfg);
+  allocations_fused(cfg);
+}
+
+// -- batches: sending bursts of messages to a single actor --------------------
+
+// Notifies `sink` after receiving `n` messages.
+behavior counting_sink(event_based_actor* self, size_t n, actor sink) {
+  auto received = std::make_shared<size_t>(0);
+  return {
+    [self, n, sink, received](int32_t) {
+      if (++*received == n)
+        self->send(sink, ok_atom_v);
+    },
+  };
+}
+
+// Compares sending bursts of messages one by one to sending them as batch.
+void batches(actor_system& sys, const config& cfg) {
+  constexpr size_t burst = 256;
+  auto rounds = std::max(cfg.iterations / burst, size_t{1});
+  std::vector<int32_t> xs(burst, 42);
+  auto run = [&](const char* name, auto send_burst) {
+    scoped_actor self{sys};
+    auto dst = sys.spawn(counting_sink, rounds * burst,
+                         actor_cast<actor>(self));
+    auto start = bench_clock::now();
+    for (size_t round = 0; round < rounds; ++round)
+      send_burst(self, dst);
+    self->receive([](ok_atom) {});
+    report(name, bench_clock::now() - start, rounds * burst);
+  };
+  run("batches/send", [&xs](scoped_actor& self, const actor& dst) {
+    for (auto x : xs)
+      self->send(dst, x);
+  });
+  run("batches/send_batch", [&xs](scoped_actor& self, const actor& dst) {
+    self->send_batch(dst, xs);
+  });
+}
+
+// -- behaviors: dispatching messages to message handlers ----------------------
+
+using int_types = detail::type_list<int8_t, int16_t, int32_t, int64_t, uint8_t,
+                                    uint16_t, uint32_t, uint64_t>;
+
+// Accepts the I-th combination of two integer types.
+template <size_t I>
+struct int_pair_handler {
+  using first = detail::tl_at_t<int_types, I / 8>;
+  using second = detail::tl_at_t<int_types, I % 8>;
+
+  size_t* count;
+
+  void operator()(first, second) const {
+    ++*count;
+  }
+};
+
+template <size_t... Is>
+behavior make_int_pair_behavior(size_t* count, std::index_sequence<Is...>) {
+  return {int_pair_handler<Is>{count}...};
+}
+
+// Compares how long behaviors with few and with many handlers need to
+// dispatch a message to their first and to their last handler.
+void behaviors(actor_system&, const config& cfg) {
+  size_t count = 0;
+  auto run = [&](const char* name, behavior& bhvr, message msg) {
+    auto start = bench_clock::now();
+    for (size_t i = 0; i < cfg.iterations; ++i)
+      bhvr(msg);
+    report(name, bench_clock::now() - start, cfg.iterations);
+  };
+  auto small = make_int_pair_behavior(&count, std::make_index_sequence<8>{});
+  auto large = make_int_pair_behavior(&count, std::make_index_sequence<64>{});
+  run("behaviors/8-handlers/first", small, make_message(int8_t{0}, int8_t{0}));
+  run("behaviors/8-handlers/last", small, make_message(int8_t{0}, uint64_t{0}));
+  run("behaviors/64-handlers/first", large,
+      make_message(int8_t{0}, int8_t{0}));
+  run("behaviors/64-handlers/last", large,
+      make_message(uint64_t{0}, uint64_t{0}));
+  if (count != 4 * cfg.iterations)
+    std::cerr << "behaviors: handlers ran " << count << " times" << std::endl;
+}
+
+// -- stash: skipping messages until a behavior change -------------------------
+
+// Stashes pings until a worker reports idle, like the server in
+// examples/dynamic_behavior/skip_messages.cpp.
+behavior stash_server(event_based_actor* self) {
+  self->set_default_handler(skip);
+  return {
+    [self](idle_atom, const actor& worker) {
+      self->become(keep_behavior, [self, worker](ping_atom atm) {
+        self->delegate(worker, atm);
+        self->unbecome();
+      });
+    },
+  };
+}
+
+behavior stash_worker(event_based_actor* self, const actor& serv) {
+  self->send(serv, idle_atom_v, self);
+  return {
+    [self, serv](ping_atom) {
+      self->send(serv, idle_atom_v, self);
+      return pong_atom_v;
+    },
+  };
+}
+
+// Measures the stash-and-replay pattern with and without a backlog of
+// messages that the server never handles.
+void stash(actor_system& sys, const config& cfg) {
+  auto pings = std::max(cfg.iterations / 10, size_t{1});
+  auto run = [&](const std::string& name, size_t backlog) {
+    scoped_actor self{sys};
+    auto serv = sys.spawn(stash_server);
+    for (size_t i = 0; i < backlog; ++i)
+      self->send(serv, static_cast<int32_t>(i));
+    auto start = bench_clock::now();
+    for (size_t i = 0; i < pings; ++i)
+      self->send(serv, ping_atom_v);
+    auto worker = sys.spawn(stash_worker, serv);
+    for (size_t i = 0; i < pings; ++i)
+      self->receive([](pong_atom) {});
+    report(name, bench_clock::now() - start, pings);
+    self->send_exit(worker, exit_reason::user_shutdown);
+    self->send_exit(serv, exit_reason::user_shutdown);
+  };
+  run("stash/no-backlog", 0);
+  run("stash/backlog-100", 100);
+  run("stash/backlog-1000", 1000);
+}
+
+// -- monitors: attaching, detaching and notifying many monitors ---------------
+
+// Notifies `sink` after receiving a down message.
+behavior down_counter(event_based_actor* self, actor sink) {
+  self->set_down_handler([self, sink](down_msg&) {
+    self->send(sink, ok_atom_v);
+  });
+  return {
+    [](int32_t) {
+      // nop
+    },
+  };
+}
+
+// Measures monitor churn on a single actor with many observers as well as
+// how long the actor needs to notify all observers when terminating.
+void monitors(actor_system& sys, const config& cfg) {
+  auto n = std::max(cfg.iterations / 100, size_t{1});
+  scoped_actor self{sys};
+  auto sink = actor_cast<actor>(self);
+  std::vector<actor> observers;
+  for (size_t i = 0; i < n; ++i)
+    observers.push_back(sys.spawn(down_counter, sink));
+  auto target = sys.spawn(down_counter, sink);
+  auto target_ptr = actor_cast<abstract_actor*>(target);
+  auto monitor_all = [&] {
+    for (auto& observer : observers)
+      target_ptr->attach(default_attachable::make_monitor(target.address(),
+                                                          observer.address()));
+  };
+  auto start = bench_clock::now();
+  monitor_all();
+  for (auto& observer : observers) {
+    default_attachable::observe_token tk{observer.address(),
+                                         default_attachable::monitor};
+    target_ptr->detach(tk);
+  }
+  report("monitors/attach-detach", bench_clock::now() - start, n * 2);
+  monitor_all();
+  start = bench_clock::now();
+  anon_send_exit(target, exit_reason::user_shutdown);
+  for (size_t i = 0; i < n; ++i)
+    self->receive([](ok_atom) {});
+  report("monitors/fan-out", bench_clock::now() - start, n);
+  for (auto& observer : observers)
+    anon_send_exit(observer, exit_reason::user_shutdown);
+}
+
+// -- pools: dispatching skewed workloads to actor pools -----------------------
+
+// Blocks the calling thread for `duration` to simulate work.
+void spin(timespan duration) {
+  auto until = bench_clock::now() + duration;
+  while (bench_clock::now() < until)
+    ; // nop
+}
+
+// Every 16th job takes 100 times longer than the others.
+behavior pool_worker(event_based_actor*) {
+  return {
+    [](int32_t x) {
+      spin(x % 16 == 0 ? timespan{100'000} : timespan{1'000});
+      return ok_atom_v;
+    },
+  };
+}
+
+// Compares dispatching policies when a few expensive jobs block workers.
+void pools(actor_system& sys, const config& cfg) {
+  constexpr size_t num_workers = 4;
+  auto jobs = std::max(cfg.iterations / 100, size_t{1});
+  auto run = [&](const std::string& name, actor_pool::policy pol) {
+    scoped_actor self{sys};
+    auto fac = [&sys] { return sys.spawn(pool_worker); };
+    auto pool = actor_pool::make(sys.dummy_execution_unit(), num_workers, fac,
+                                 std::move(pol));
+    auto start = bench_clock::now();
+    for (size_t i = 0; i < jobs; ++i)
+      self->send(pool, static_cast<int32_t>(i));
+    for (size_t i = 0; i < jobs; ++i)
+      self->receive([](ok_atom) {});
+    report(name, bench_clock::now() - start, jobs);
+    self->send_exit(pool, exit_reason::user_shutdown);
+  };
+  auto key = [](const message& msg) {
+    return static_cast<uint64_t>(msg.get_as<int32_t>(0));
+  };
+  run("pools/round-robin", actor_pool::round_robin());
+  run("pools/random", actor_pool::random());
+  run("pools/least-loaded", actor_pool::least_loaded());
+  run("pools/power-of-two", actor_pool::power_of_two());
+  run("pools/consistent-hash", actor_pool::consistent_hash(key));
+}
+
+// -- registry: looking up and churning actors by ID ---------------------------
+
+// Measures registering and removing actors as they spawn and terminate as
+// well as looking up registered actors, each with concurrent threads.
+void registry(actor_system& sys, const config& cfg) {
+  auto& reg = sys.registry();
+  auto per_thread = std::max(cfg.iterations / 10 / cfg.producers, size_t{1});
+  auto run = [&](const char* name, size_t ops, auto fn) {
+    std::vector<std::thread> threads;
+    auto start = bench_clock::now();
+    for (size_t i = 0; i < cfg.producers; ++i)
+      threads.emplace_back(fn, i);
+    for (auto& t : threads)
+      t.join();
+    report(name, bench_clock::now() - start, ops * cfg.producers);
+  };
+  run("registry/spawn-terminate", per_thread, [&](size_t) {
+    for (size_t i = 0; i < per_thread; ++i) {
+      auto hdl = sys.spawn([] {});
+      reg.put(hdl->id(), hdl);
+    }
+  });
+  sys.await_all_actors_done();
+  std::vector<actor> hdls;
+  for (size_t i = 0; i < 1024; ++i) {
+    hdls.push_back(sys.spawn(counting_sink, size_t{0}, actor{}));
+    reg.put(hdls.back()->id(), hdls.back());
+  }
+  run("registry/lookup", cfg.iterations, [&](size_t offset) {
+    for (size_t i = 0; i < cfg.iterations; ++i)
+      if (!reg.get(hdls[(i + offset) % hdls.size()]->id()))
+        std::cerr << "registry: lookup failed" << std::endl;
+  });
+  for (auto& hdl : hdls)
+    anon_send_exit(hdl, exit_reason::user_shutdown);
+}
+
+// -- spawns: creating and destroying short-lived actors -----------------------
+
+// Terminates right after starting, since its behavior is empty.
+class short_lived : public event_based_actor {
+public:
+  using event_based_actor::event_based_actor;
+
+  behavior make_behavior() override {
+    return {};
+  }
+};
+
+// Compares spawning actors one by one to spawning them in bulk. Terminated
+// actors return their memory to the actor storage cache, which subsequent
+// spawns reuse.
+void spawns(actor_system& sys, const config& cfg) {
+  constexpr size_t bulk = 100;
+  auto rounds = std::max(cfg.iterations / 10 / bulk, size_t{1});
+  auto run = [&](const char* name, auto spawn_bulk) {
+    auto start = bench_clock::now();
+    for (size_t round = 0; round < rounds; ++round)
+      spawn_bulk();
+    sys.await_all_actors_done();
+    report(name, bench_clock::now() - start, rounds * bulk);
+  };
+  run("spawns/spawn", [&sys] {
+    for (size_t i = 0; i < bulk; ++i)
+      sys.spawn<short_lived>();
+  });
+  run("spawns/spawn_n", [&sys] { sys.spawn_n<short_lived>(bulk); });
+}
+
+// -- detached: running short-lived actors in their own thread ---------------
+
+// Spawns detached actors one after another. Each actor terminates right away,
+// which allows the private thread pool to hand its thread to the next actor.
+void detached_actors(actor_system& sys, const config& cfg) {
+  auto n = std::max(cfg.iterations / 1000, size_t{1});
+  auto reused = [&sys] {
+    return sys.base_metrics().reused_private_threads->value();
+  };
+  auto reused_before = reused();
+  scoped_actor self{sys};
+  auto start = bench_clock::now();
+  for (size_t i = 0; i < n; ++i)
+    self->wait_for(sys.spawn<short_lived, detached>());
+  report("detached/spawn", bench_clock::now() - start, n);
+  std::cout << "detached/reused-threads: " << (reused() - reused_before)
+            << '\n';
+}
+
+// -- benchmark registry -------------------------------------------------------
+
+using bench_fun = void (*)(actor_system&, const config&);
+
+const std::map<std::string, bench_fun> benchmarks{
+  {"allocations", allocations},
+  {"batches", batches},
+  {"behaviors", behaviors},
+  {"deque", deque},
+  {"detached", detached_actors},
+  {"fan-out", fan_out},
+  {"monitors", monitors},
+  {"pools", pools},
+  {"registry", registry},
+  {"shards", shards},
+  {"spawns", spawns},
+  {"stash", stash},
+};
+
+} // namespace
+
+void caf_main(actor_system& sys, const config& cfg) {
+  if (cfg.benchmark.empty()) {
+    for (auto& [name, fun] : benchmarks)
+      fun(sys, cfg);
+    return;
+  }
+  if (auto i = benchmarks.find(cfg.benchmark); i != benchmarks.end()) {
+    i->second(sys, cfg);
+    return;
+  }
+  std::cerr << "unknown benchmark: " << cfg.benchmark << std::endl;
+}
+
+CAF_MAIN()